@@ -28,6 +28,8 @@
 #define COSOCO_ATTRIBUTELIST_H
 
 #include "UTF8String.h"
+#include "XMLTags.h"
+#include <cstring>
 #include <libxml/xmlstring.h>
 
 namespace XCSP3Core {
@@ -43,11 +45,14 @@ namespace XCSP3Core {
          */
         AttributeList() {
             n = 0;
+            stride = 2;
             list = NULL;
+            findKnownAttributes();
         }
 
         AttributeList(const Byte** attr) {
             list = attr;
+            stride = 2;
 
             n = 0;
             if (list == NULL)
@@ -57,6 +62,19 @@ namespace XCSP3Core {
                 n += 2;
 
             n /= 2;
+            findKnownAttributes();
+        }
+
+        /**
+         * the attribute list given by the SAX2 interface of libxml2: nb attributes,
+         * 5 entries per attribute (localname, prefix, URI, value, end of value).
+         * Values are not NUL terminated.
+         */
+        AttributeList(const Byte** attr, int nb) {
+            list = attr;
+            stride = 5;
+            n = nb;
+            findKnownAttributes();
         }
 
         inline int size() const {
@@ -65,24 +83,49 @@ namespace XCSP3Core {
 
         UTF8String operator[](const char* name) const {
             for (int i = 0; i < n; ++i)
-                if (xmlStrEqual(list[2 * i], reinterpret_cast<const Byte*>(name)))
-                    return UTF8String(list[2 * i + 1]);
+                if (xmlStrEqual(list[stride * i], reinterpret_cast<const Byte*>(name)))
+                    return getValue(i);
 
             return UTF8String();
         }
 
+        /**
+         * the value of a known attribute (found once, when the list is built)
+         */
+        inline UTF8String operator[](AttributeType type) const {
+            int i = known[static_cast<int>(type)];
+            return i < 0 ? UTF8String() : getValue(i);
+        }
+
         inline UTF8String getName(int i) const {
-            return UTF8String(list[2 * i]);
+            return UTF8String(list[stride * i]);
         }
 
         inline UTF8String getValue(int i) const {
-            return UTF8String(list[2 * i + 1]);
+            if (stride == 2)
+                return UTF8String(list[2 * i + 1]);
+            return UTF8String(list[5 * i + 3], list[5 * i + 4]);
         }
 
     private:
         int n;             // number of attributes
-        const Byte** list; // list[2*i] is the name of the i-th attribute,
-        // list[2*i+1] is its value
+        int stride;        // number of entries per attribute
+        const Byte** list; // list[stride*i] is the name of the i-th attribute,
+        // followed by its value (SAX1), or by its prefix, URI, value and end of value (SAX2)
+        signed char known[static_cast<int>(AttributeType::NB)]; // index of each known attribute, -1 if absent
+
+        /**
+         * one pass on the names to locate the attributes known by the parser
+         */
+        void findKnownAttributes() {
+            memset(known, -1, sizeof(known));
+            for (int i = 0; i < n && i < 128; ++i) {
+                const Byte* name = list[stride * i];
+                int type = static_cast<int>(attributeType(name, strlen(reinterpret_cast<const char*>(name))));
+                if (type != static_cast<int>(AttributeType::NB) && known[type] < 0)
+                    known[type] = i;
+            }
+        }
     };
 
 } // namespace XCSP3Core
@@ -92,9 +92,15 @@ namespace XCSP3Core {
 
             iterator(const iterator&) = default;
 
-            int operator*();
+            // ASCII characters are decoded inline, the others by decode()
+            inline int operator*() {
+                return *p < 0x80 ? *p : decode();
+            }
 
-            iterator& operator++();
+            inline iterator& operator++() {
+                p += *p < 0x80 ? 1 : codeLength(*p);
+                return *this;
+            }
 
             iterator operator++(int);
 
@@ -117,15 +123,21 @@ namespace XCSP3Core {
             }
 
         protected:
+            int decode();
+
             /**
              * return the number of bytes of the current code point
              */
             inline int codeLength(int ch) {
+#ifdef XCSP3_TRUSTED_UTF8
+                // the input is known to be valid UTF-8 (libxml2 already checked it)
+                return ch < 0x80 ? 1 : ch < 0xE0 ? 2 : ch < 0xF0 ? 3 : 4;
+#else
                 if (ch < 0x80)
                     return 1; // only one byte
                 else if (ch < 0xC2)
                     throw std::runtime_error("invalid UTF8 character");
-                else if (ch < 0xD0)
+                else if (ch < 0xE0)
                     return 2; // 2 bytes
                 else if (ch < 0xF0)
                     return 3; // 3 bytes
@@ -133,13 +145,16 @@ namespace XCSP3Core {
                     return 4; // 4 bytes
                 else
                     throw std::runtime_error("invalid UTF8 character");
+#endif
             }
 
             inline void addNextByte(int& ch) {
                 ch <<= 6;
                 ++p;
+#ifndef XCSP3_TRUSTED_UTF8
                 if (*p < 0x80 || *p >= 0xC0)
                     throw std::runtime_error("invalid UTF8 character");
+#endif
                 ch |= *p & 0x3F;
             }
         };
@@ -178,11 +193,29 @@ namespace XCSP3Core {
 
         friend std::ostream& operator<<(std::ostream& f, const UTF8String s);
 
+        /**
+         * return true if the bytes are all ASCII characters (checked with SIMD instructions when available)
+         */
+        static bool isAscii(const Byte* b, const Byte* e);
+
         class Tokenizer {
         private:
             iterator it, end;
             std::vector<int> separators;
 
+            // When the text is pure ASCII, tokens are delimited byte per byte with
+            // this table instead of decoding code points
+            enum ByteClass : unsigned char {
+                TOKEN,
+                SPACE,
+                SEPARATOR,
+                NUL
+            };
+            bool ascii;
+            unsigned char byteClass[256];
+            char asciiSeparators[8]; // separators compared by the SIMD token scan
+            int nbAsciiSeparators;   // -1 if there are too many separators for the SIMD scan
+
         public:
             Tokenizer(const UTF8String s);
             void addSeparator(int ch);
@@ -191,6 +224,9 @@ namespace XCSP3Core {
 
         protected:
             inline bool isSeparator(int ch) {
+                if (ch < 128)
+                    return byteClass[ch] == SEPARATOR;
+
                 for (std::vector<int>::const_iterator it = separators.begin();
                      it != separators.end(); ++it)
                     if (*it == ch)
@@ -200,9 +236,21 @@ namespace XCSP3Core {
             }
 
             inline void skipWhiteSpace() {
+                if (ascii) {
+                    const Byte *p = it.getPointer(), *e = end.getPointer();
+                    while (p != e && byteClass[*p] == SPACE)
+                        ++p;
+                    it = iterator(p);
+                    return;
+                }
                 while (it != end && *it && it.isWhiteSpace())
                     ++it;
             }
+
+            /**
+             * the end of the token starting at p (ASCII text only)
+             */
+            const Byte* tokenEnd(const Byte* p, const Byte* e) const;
         };
 
     protected:
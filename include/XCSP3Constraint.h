@@ -43,7 +43,7 @@ namespace XCSP3Core {
      **************************************************************************/
     class XConstraint {
     public:
-        std::string id;
+        Symbol id;
         std::vector<XVariable*> list;
         std::string classes;
 
@@ -65,8 +65,9 @@ namespace XCSP3Core {
         std::vector<std::vector<XVariable*>> arguments; // The list of all arguments
         ConstraintType type;                            // Use it to discover the type of constraint... and perform cast
         std::map<std::string, XVariable*> toArguments;
+        int maxParameter; // The largest parameter number in the constraint (%... is replaced by the next arguments)
 
-        XConstraintGroup(std::string idd, std::string c) : XConstraint(idd, c), constraint(NULL), type(ConstraintType::UNKNOWN) {}
+        XConstraintGroup(std::string idd, std::string c) : XConstraint(idd, c), constraint(NULL), type(ConstraintType::UNKNOWN), maxParameter(-1) {}
 
         virtual ~XConstraintGroup() {  }
 
@@ -175,17 +176,15 @@ namespace XCSP3Core {
         std::string to;
     };
 
-    extern std::vector<XTransition> tr; // Not beautiful but remove code to fixed data in group constraint.
-    extern std::string st;
-    extern std::vector<std::string> fi;
-
     class XConstraintRegular : public XConstraint {
     public:
-        std::string& start;
-        std::vector<std::string>& final;
-        std::vector<XTransition>& transitions;
+        std::string start;
+        std::vector<std::string> final;
+        std::vector<XTransition> transitions;
+
+        XConstraintRegular(std::string idd, std::string c) : XConstraint(idd, c) {}
 
-        XConstraintRegular(std::string idd, std::string c) : XConstraint(idd, c), start(st), final(fi), transitions(tr) {}
+        void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
 
     /***************************************************************************
@@ -194,9 +193,11 @@ namespace XCSP3Core {
 
     class XConstraintMDD : public XConstraint {
     public:
-        std::vector<XTransition>& transitions;
+        std::vector<XTransition> transitions;
+
+        XConstraintMDD(std::string idd, std::string c) : XConstraint(idd, c) {}
 
-        XConstraintMDD(std::string idd, std::string c) : XConstraint(idd, c), transitions(tr) {}
+        void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
 
     /***************************************************************************
@@ -204,13 +205,13 @@ namespace XCSP3Core {
      *                  COMPARISON BASED CONSTRAINTS
      ****************************************************************************
      ***************************************************************************/
-    extern std::vector<int> _except;
-
     class XConstraintAllDiff : public XConstraint {
     public:
-        std::vector<int>& except;
+        std::vector<int> except;
+
+        XConstraintAllDiff(std::string idd, std::string c) : XConstraint(idd, c) {}
 
-        XConstraintAllDiff(std::string idd, std::string c) : XConstraint(idd, c), except(_except) {}
+        void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
 
     class XConstraintAllDiffMatrix : public XConstraint {
@@ -236,13 +237,11 @@ namespace XCSP3Core {
      * constraint ordered and lex
      **************************************************************************/
 
-    extern OrderType _op;
-
     class XConstraintOrdered : public XConstraint, public XLengths {
     public:
-        OrderType& op;
+        OrderType op;
 
-        XConstraintOrdered(std::string idd, std::string c) : XConstraint(idd, c), op(_op) {}
+        XConstraintOrdered(std::string idd, std::string c) : XConstraint(idd, c), op(OrderType::LE) {}
         void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
 
@@ -288,9 +287,9 @@ namespace XCSP3Core {
 
     class XConstraintNValues : public XConstraint, public XInitialCondition {
     public:
-        std::vector<int>& except;
+        std::vector<int> except;
 
-        XConstraintNValues(std::string idd, std::string c) : XConstraint(idd, c), except(_except) {}
+        XConstraintNValues(std::string idd, std::string c) : XConstraint(idd, c) {}
 
         void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
@@ -442,13 +441,13 @@ namespace XCSP3Core {
      * constraint instantiation
      **************************************************************************/
 
-    extern std::vector<int> _values;
-
     class XConstraintInstantiation : public XConstraint {
     public:
-        std::vector<int>& values;
+        std::vector<int> values;
+
+        XConstraintInstantiation(std::string idd, std::string c) : XConstraint(idd, c) {}
 
-        XConstraintInstantiation(std::string idd, std::string c) : XConstraint(idd, c), values(_values) {}
+        void unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) override;
     };
 
     /***************************************************************************
@@ -29,6 +29,7 @@
 #include "XCSP3Constraint.h"
 #include "XCSP3Tree.h"
 #include "XCSP3Variable.h"
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -71,12 +72,21 @@ namespace XCSP3Core {
          */
         bool normalizeSum;
 
+        /**
+         * If true, the lists of variables of the constraints, objectives and annotations which have a callback
+         * with XHandles (see the end of this class) are given as handles instead of XVariable*
+         * (false by default). The handles are numbered from 0 in the order of the calls to buildVariableInteger.
+         * Lists containing something else than variables (integers, expressions...) are still given as XVariable*.
+         */
+        bool useHandles;
+
         XCSP3CoreCallbacksBase() {
             intensionUsingString = false;
             recognizeSpecialIntensionCases = true;
             recognizeSpecialCountCases = true;
             recognizeNValuesCases = true;
             normalizeSum = true;
+            useHandles = false;
         }
 
         /**
@@ -277,6 +287,24 @@ namespace XCSP3Core {
         */
         virtual void buildVariableInteger(const std::string& id, const std::vector<int>& values) = 0;
 
+        /**
+         * The callback function called by the parser for each integer variable. By default, it calls one of the two
+         * functions above: the one with a range if the values of the domain are consecutive, however they are written
+         * (1..3 or 1 2 3), the one with the values otherwise. Override it to get the intervals of the domain
+         * (domain.values) without the list of its values, or to recognize the domains already seen: the variables
+         * with the same values have the same domain (domain.id), written as where it first appears.
+         * See http://xcsp.org/specifications/integers
+         *
+         * @param id the id (name) of the variable
+         * @param domain its domain, which lives until the end of the parse
+         */
+        virtual void buildVariableInteger(const std::string& id, const XDomainInteger& domain) {
+            if (domain.isInterval())
+                buildVariableInteger(id, domain.minimum(), domain.maximum());
+            else
+                buildVariableInteger(id, domain.allValues());
+        }
+
         /**
          * All callbacks related to constraints.
          * Note that the variables related to a constraint are #XVariable instances. A XVariable contains an id and
@@ -1939,6 +1967,145 @@ namespace XCSP3Core {
          */
 
         virtual void buildAnnotationDecision(std::vector<XVariable*>& list) = 0;
+
+        //--------------------------------------------------------------------------------------
+        // Callbacks with handles, called instead of the ones above if useHandles is true.
+        // Override the ones related to the constraints of your instances.
+        //--------------------------------------------------------------------------------------
+
+        /**
+         * See buildConstraintExtension above
+         */
+        virtual void buildConstraintExtension(const std::string& id, XHandles list, const std::vector<std::vector<int>>& tuples, bool support, bool hasStar) {
+            (void)list;
+            (void)tuples;
+            (void)support;
+            (void)hasStar;
+            unsupportedHandles("extension", id);
+        }
+
+        /**
+         * See buildConstraintExtensionAs above
+         */
+        virtual void buildConstraintExtensionAs(const std::string& id, XHandles list, bool support, bool hasStar) {
+            (void)list;
+            (void)support;
+            (void)hasStar;
+            unsupportedHandles("extension", id);
+        }
+
+        /**
+         * See buildConstraintAlldifferent above
+         */
+        virtual void buildConstraintAlldifferent(const std::string& id, XHandles list) {
+            (void)list;
+            unsupportedHandles("allDifferent", id);
+        }
+
+        /**
+         * See buildConstraintAllEqual above
+         */
+        virtual void buildConstraintAllEqual(const std::string& id, XHandles list) {
+            (void)list;
+            unsupportedHandles("allEqual", id);
+        }
+
+        /**
+         * See buildConstraintOrdered above
+         */
+        virtual void buildConstraintOrdered(const std::string& id, XHandles list, OrderType order) {
+            (void)list;
+            (void)order;
+            unsupportedHandles("ordered", id);
+        }
+
+        /**
+         * See buildConstraintSum above
+         */
+        virtual void buildConstraintSum(const std::string& id, XHandles list, const std::vector<int>& coeffs, XCondition& cond) {
+            (void)list;
+            (void)coeffs;
+            (void)cond;
+            unsupportedHandles("sum", id);
+        }
+
+        /**
+         * See buildConstraintSum above
+         */
+        virtual void buildConstraintSum(const std::string& id, XHandles list, XCondition& cond) {
+            (void)list;
+            (void)cond;
+            unsupportedHandles("sum", id);
+        }
+
+        /**
+         * See buildConstraintInstantiation above
+         */
+        virtual void buildConstraintInstantiation(const std::string& id, XHandles list, const std::vector<int>& values) {
+            (void)list;
+            (void)values;
+            unsupportedHandles("instantiation", id);
+        }
+
+        /**
+         * See buildConstraintClause above
+         */
+        virtual void buildConstraintClause(const std::string& id, XHandles positive, XHandles negative) {
+            (void)positive;
+            (void)negative;
+            unsupportedHandles("clause", id);
+        }
+
+        /**
+         * See buildObjectiveMinimize above
+         */
+        virtual void buildObjectiveMinimize(ExpressionObjective type, XHandles list, const std::vector<int>& coefs) {
+            (void)type;
+            (void)list;
+            (void)coefs;
+            unsupportedHandles("minimize", "");
+        }
+
+        /**
+         * See buildObjectiveMaximize above
+         */
+        virtual void buildObjectiveMaximize(ExpressionObjective type, XHandles list, const std::vector<int>& coefs) {
+            (void)type;
+            (void)list;
+            (void)coefs;
+            unsupportedHandles("maximize", "");
+        }
+
+        /**
+         * See buildObjectiveMinimize above
+         */
+        virtual void buildObjectiveMinimize(ExpressionObjective type, XHandles list) {
+            (void)type;
+            (void)list;
+            unsupportedHandles("minimize", "");
+        }
+
+        /**
+         * See buildObjectiveMaximize above
+         */
+        virtual void buildObjectiveMaximize(ExpressionObjective type, XHandles list) {
+            (void)type;
+            (void)list;
+            unsupportedHandles("maximize", "");
+        }
+
+        /**
+         * See buildAnnotationDecision above
+         */
+        virtual void buildAnnotationDecision(XHandles list) {
+            (void)list;
+            unsupportedHandles("decision", "");
+        }
+
+    private:
+        static void unsupportedHandles(const std::string& what, const std::string& id) {
+            throw std::runtime_error(what + " " + id + ": this callback with handles is not implemented (see useHandles)");
+        }
     };
 
 } // namespace XCSP3Core
@@ -26,19 +26,36 @@
 #ifndef _XMLParser_libxml2_h_
 #define _XMLParser_libxml2_h_
 
+#include <atomic>
 #include <cerrno>
 #include <climits>
+#include <functional>
 #include <iostream>
 #include <libxml/parser.h>
+#include <memory>
 #include <stdexcept>
 
 #include "UTF8String.h"
 #include "XCSP3Constants.h"
 #include "XCSP3CoreCallbacks.h"
+#include "XCSP3Index.h"
 #include "XMLParser.h"
 
 namespace XCSP3Core {
 
+    /**
+     * How far a parse went (see XCSP3CoreParser::progress)
+     */
+    struct XCSP3Progress {
+        size_t bytes;       // bytes of the document given to the parser so far (after decompression)
+        size_t total;       // size of the document, 0 if it is unknown (streams, compressed documents)
+        TagType section;    // the current child of the root (VARIABLES, CONSTRAINTS...)
+        size_t constraints; // number of constraints read so far (groups, slides... included)
+        double elapsed;     // seconds since the beginning of the parse
+
+        XCSP3Progress() : bytes(0), total(0), section(TagType::UNKNOWN), constraints(0), elapsed(0) {}
+    };
+
     /**
      * @brief the parser using the libxml2 library
      */
@@ -47,16 +64,218 @@ namespace XCSP3Core {
     protected:
         XMLParser cspParser;
 
+        // If true (see XCSP3ParserSession), the libxml2 context, the read buffer and the memory
+        // of the pools are kept from one parse to the next
+        bool warm;
+        xmlParserCtxtPtr context;
+        std::unique_ptr<char[]> readBuffer;
+        size_t readBufferSize;
+
     public:
-        XCSP3CoreParser(XCSP3CoreCallbacksBase* cb) : cspParser(cb) {
-            LIBXML_TEST_VERSION
+        /**
+         * If true, the file mapped by parse(const char *filename) and the memory of the objects
+         * built by the parser are advised to be backed by huge pages.
+         * This is only a hint, ignored when the system does not support it.
+         * (false by default)
+         */
+        bool hugePages;
+
+        /**
+         * If true, streams and files are read by a separate thread which fills a ring
+         * of chunks ahead of the parser: reading and parsing overlap.
+         * Files are then read with pread instead of being memory mapped.
+         * (false by default)
+         */
+        bool prefetch;
+
+        /**
+         * Size in bytes of the chunks read from streams and files (1 MiB by default)
+         */
+        size_t chunkSize;
+
+        /**
+         * Number of chunks of the prefetch ring, i.e. how far the reader thread can be
+         * ahead of the parser (4 by default, at least 2)
+         */
+        int queueDepth;
+
+        /**
+         * If true, documents available in memory (see parse(const void *data, size_t len))
+         * and memory mapped files are scanned by the XMLTokenizer instead of libxml2.
+         * libxml2 is still used for streams, compressed documents, and documents using
+         * XML features unknown to the tokenizer (DTD, entities...).
+         * (false by default)
+         */
+        bool nativeTokenizer;
+
+        /**
+         * If true, the document is assumed to be valid (for instance, generated and already
+         * checked by ourselves): the parent of each tag and the absence of text in tags
+         * without text are not checked anymore. UTF-8 sequences are still checked, unless
+         * the library is built with XCSP3_TRUSTED_UTF8.
+         * (false by default)
+         */
+        bool trusted;
+
+        /**
+         * Number of threads parsing the constraints of documents available in memory and of
+         * memory mapped files (1 by default). With more threads, the document is first indexed
+         * (see XCSP3Index); the variables are parsed by the calling thread, then the top-level
+         * constraints are split in shards parsed by worker threads. The callbacks are always
+         * called by the calling thread, never concurrently.
+         */
+        int threads;
+
+        /**
+         * If true, the constraints parsed by worker threads (see threads) are given to the
+         * callbacks shard by shard as soon as they are parsed, instead of in the document order.
+         * (false by default)
+         */
+        bool outOfOrder;
+
+        /**
+         * If set, called every progressStep bytes of the document with the progress of the
+         * parse, then once at the end. It is called by the thread calling parse, between two chunks.
+         */
+        std::function<void(const XCSP3Progress&)> progress;
+
+        /**
+         * Number of bytes between two calls to progress (1 MiB by default)
+         */
+        size_t progressStep;
+
+        /**
+         * If set, the parse stops as soon as the flag becomes true, possibly from another thread
+         * (nullptr by default)
+         */
+        const std::atomic<bool>* cancel;
+
+        /**
+         * If positive, the parse stops when it lasts more than this number of seconds (0 by default)
+         */
+        double timeLimit;
+
+        /**
+         * If true, the objects built by the parser are neither destroyed nor released at the end
+         * of the parse: for programs which exit right after it (false by default)
+         */
+        bool leakObjects;
+
+        /**
+         * The values returned by parse
+         */
+        static const int COMPLETE = 0;  // the whole document was parsed
+        static const int CANCELLED = 1; // the parse was stopped by cancel
+        static const int TIMEOUT = 2;   // the parse was stopped by timeLimit
+
+        /**
+         * How far the last parse went, updated between chunks and at the end of the parse
+         */
+        XCSP3Progress reached;
+
+        XCSP3CoreParser(XCSP3CoreCallbacksBase* cb)
+            : cspParser(cb), warm(false), context(nullptr), readBufferSize(0), hugePages(false), prefetch(false), chunkSize(1 << 20),
+              queueDepth(4), nativeTokenizer(false), trusted(false), threads(1), outOfOrder(false), progressStep(1 << 20),
+              cancel(nullptr), timeLimit(0), leakObjects(false) {
+            initLibrary();
         }
 
+        virtual ~XCSP3CoreParser();
+
+        XCSP3CoreParser(const XCSP3CoreParser&) = delete;
+        XCSP3CoreParser& operator=(const XCSP3CoreParser&) = delete;
+
+        /**
+         * Parse a document read from a stream. Documents compressed with gzip, bzip2,
+         * xz or lzma are detected from their first bytes and decompressed on the fly.
+         */
         int parse(std::istream& in);
 
+        /**
+         * Parse the given file. Regular files are memory mapped and handed to libxml2
+         * without any intermediate copy, other files (pipes...) are read as a stream.
+         * With the prefetch option, all files are read by the prefetch thread.
+         * As for streams, compressed files are decompressed on the fly.
+         */
         int parse(const char* filename);
 
+        /**
+         * Parse a document entirely available in memory (cache, shared memory segment...).
+         * The bytes are handed to libxml2 as they are, without any intermediate copy.
+         * Compressed documents are decompressed on the fly.
+         */
+        int parse(const void* data, size_t len);
+
+        /**
+         * Build the index of the given file (see XCSP3Index). The file must be a regular,
+         * uncompressed file.
+         */
+        static XCSP3Index buildIndex(const char* filename);
+
+        /**
+         * Parse the given file, keeping only the top-level constraints (children of
+         * <constraints>) selected by select. The variables are always parsed, the objectives
+         * and annotations are not. The index must have been built on this very file.
+         */
+        int parse(const char* filename, const XCSP3Index& index, const XCSP3Index::Filter& select);
+
     protected:
+        /**
+         * Read at most size bytes into the buffer, return 0 at the end of the input
+         */
+        typedef std::function<size_t(char*, size_t)> Source;
+
+        /**
+         * Parse a document read chunk by chunk from the source, possibly by a prefetch thread
+         */
+        int parseSource(const Source& read);
+
+        /**
+         * Parse the document made of the given slices [first, second) of data, in this order
+         */
+        int parseSlices(const char* data, const std::vector<std::pair<size_t, size_t>>& slices);
+
+        /**
+         * Parse a document in memory with worker threads (see threads)
+         */
+        int parseInParallel(const char* data, size_t size);
+
+        /**
+         * Copy the options to the XMLParser before a parse
+         */
+        void prepare();
+
+        /**
+         * Destroy the objects built during the parse (see leakObjects)
+         */
+        void releaseObjects();
+
+        /**
+         * Releases the objects built during the parse when it goes out of scope,
+         * whether the parse completes, stops or fails
+         */
+        class ObjectsRelease {
+            XCSP3CoreParser& parser;
+
+        public:
+            explicit ObjectsRelease(XCSP3CoreParser& p) : parser(p) {}
+
+            ~ObjectsRelease() {
+                parser.releaseObjects();
+            }
+
+            ObjectsRelease(const ObjectsRelease&) = delete;
+            ObjectsRelease& operator=(const ObjectsRelease&) = delete;
+        };
+
+        /**
+         * Check the libxml2 version and initialize the library, once per process.
+         * The library is never cleaned up between two parses.
+         */
+        static void initLibrary();
+
+        static void initHandler(xmlSAXHandler& handler);
+
         /*************************************************************************
          *
          * SAX Handler
@@ -71,9 +290,11 @@ namespace XCSP3Core {
 
         static void characters(void* parser, const xmlChar* ch, int len);
 
-        static void startElement(void* parser, const xmlChar* name, const xmlChar** attr);
+        static void startElementNs(void* parser, const xmlChar* localname, const xmlChar* prefix, const xmlChar* URI,
+                                   int nb_namespaces, const xmlChar** namespaces, int nb_attributes, int nb_defaulted,
+                                   const xmlChar** attributes);
 
-        static void endElement(void* parser, const xmlChar* name);
+        static void endElementNs(void* parser, const xmlChar* localname, const xmlChar* prefix, const xmlChar* URI);
     };
 
 } // namespace XCSP3Core
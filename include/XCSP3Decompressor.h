@@ -0,0 +1,83 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3DECOMPRESSOR_H
+#define XCSP3DECOMPRESSOR_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace XCSP3Core {
+
+    /**
+     * Streaming decompression of compressed instances (.gz, .bz2, .xz, .lzma).
+     * Compressed data is given chunk by chunk, the decompressed data is handed
+     * to a callback each time the (fixed size) output buffer is full.
+     * Nothing is ever decompressed as a whole in memory.
+     */
+    class XCSP3Decompressor {
+    public:
+        enum class Format {
+            NONE,
+            GZIP,
+            BZIP2,
+            XZ,
+            LZMA
+        };
+
+        typedef std::function<void(const char*, size_t)> Output;
+
+        /**
+         * Identify the compression format from the first bytes of the data.
+         * Return NONE if the data does not look compressed.
+         */
+        static Format detect(const char* data, size_t size);
+
+        /**
+         * Create a decompressor for the given format.
+         * Throw an exception if the parser was built without the related library.
+         */
+        static std::unique_ptr<XCSP3Decompressor> create(Format format);
+
+        virtual ~XCSP3Decompressor() {}
+
+        /**
+         * Decompress the next chunk of compressed data
+         */
+        virtual void decompress(const char* data, size_t size, const Output& output) = 0;
+
+        /**
+         * Flush the remaining decompressed data. Throw an exception if the
+         * compressed stream is truncated.
+         */
+        virtual void finish(const Output& output) = 0;
+
+    protected:
+        static const size_t outSize = (1 << 20);
+    };
+
+} // namespace XCSP3Core
+
+#endif /* XCSP3DECOMPRESSOR_H */
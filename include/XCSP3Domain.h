@@ -27,6 +27,7 @@
 #define XDOMAIN_H
 
 #include "XCSP3Pool.h"
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
@@ -104,21 +105,100 @@ namespace XCSP3Core {
         virtual ~XDomain() { }
     };
 
+    /**
+     * The domain of an integer variable: its values and intervals, in increasing order, in a vector.
+     * When there are many of them within a small span, the domain is stored as a bitset instead.
+     */
     class XDomainInteger : public XDomain {
-        //        friend class XMLParser;
+    public:
+        // An interval of values, a single value if min == max
+        struct Interval {
+            int min, max;
+
+            int minimum() const { return min; }
+
+            int maximum() const { return max; }
+
+            int width() const { return max - min + 1; }
+
+            const Interval* operator->() const { return this; }
+        };
+
+        /**
+         * A read-only view of the values and intervals of a domain, as written in the instance where the
+         * domain first appears (maximal intervals once the domain is a bitset). Its elements are Intervals.
+         */
+        class Values {
+            const XDomainInteger& domain;
+
+        public:
+            class iterator {
+                const XDomainInteger* domain;
+                size_t position; // an index in intervals, or a bit of the bitset
+                Interval current;
+
+                void find(); // the interval (the run of bits) at position
+
+            public:
+                iterator(const XDomainInteger* d, size_t p) : domain(d), position(p) { find(); }
+
+                Interval operator*() const { return current; }
+
+                const Interval* operator->() const { return &current; }
+
+                iterator& operator++() {
+                    position = domain->bits.empty() ? position + 1 : position + current.width();
+                    find();
+                    return *this;
+                }
+
+                bool operator==(const iterator& other) const { return position == other.position; }
+
+                bool operator!=(const iterator& other) const { return position != other.position; }
+            };
+
+            explicit Values(const XDomainInteger& d) : domain(d) {}
+
+            Values(const Values&) = delete;
+            Values& operator=(const Values&) = delete;
+
+            size_t size() const { return domain.bits.empty() ? domain.intervals.size() : domain.nbRuns; }
+
+            bool empty() const { return domain.size == 0; }
+
+            iterator begin() const { return iterator(&domain, 0); }
+
+            iterator end() const { return iterator(&domain, domain.bits.empty() ? domain.intervals.size() : domain.bits.size() * 64); }
+
+            // O(1) on a vector of intervals, linear on a bitset: prefer the iterators
+            Interval operator[](size_t i) const;
+        };
+
     protected:
         int size;
         int top{std::numeric_limits<int>::min()};
 
-        void addEntity(XIntegerEntity* e) {
-            values.push_back(e);
-            size += e->width();
-        }
+        std::vector<Interval> intervals; // the domain, unless it is a bitset
+        int base;                        // the bitset: base + i is in the domain iff the bit i is set
+        std::vector<uint64_t> bits;
+        size_t nbRuns;                   // the number of maximal intervals of the bitset
+        mutable std::vector<int> expanded; // all the values, computed by allValues
+
+        void setBits(int min, int max);
+        void toBitset();
+        void toIntervals();
+        void add(int min, int max);
 
     public:
-        std::vector<XIntegerEntity*> values;
+        static const uint32_t NO_ID = UINT32_MAX;
 
-        XDomainInteger() : size(0) {}
+        const Values values;
+        uint32_t id; // the number of the domain in its XDomainTable, NO_ID if it is in none
+
+        XDomainInteger() : size(0), base(0), nbRuns(0), values(*this), id(NO_ID) {}
+
+        XDomainInteger(const XDomainInteger&) = delete;
+        XDomainInteger& operator=(const XDomainInteger&) = delete;
 
         virtual ~XDomainInteger() {}
 
@@ -126,44 +206,80 @@ namespace XCSP3Core {
             return size;
         }
 
-        int minimum() {
-            return values[0]->minimum();
+        int minimum() const {
+            return bits.empty() ? intervals[0].min : base;
         }
 
-        int maximum() {
-            return values[values.size() - 1]->maximum();
+        int maximum() const {
+            return top;
         }
 
-        int isInterval() {
-            return size == maximum() - minimum() + 1;
+        // true if the values are consecutive, however they are written
+        int isInterval() const {
+            return size > 0 && size == static_cast<int64_t>(maximum()) - minimum() + 1;
+        }
+
+        // O(log n) on a vector of intervals, O(1) on a bitset
+        bool contains(int v) const;
+
+        // All the values of the domain, computed the first time and kept by the domain (which is not
+        // modified anymore once in a XDomainTable). Not to be called by several threads at the same time.
+        const std::vector<int>& allValues() const;
+
+        bool isBitset() const {
+            return !bits.empty();
         }
 
         void addValue(int v) {
             if (v <= top)
                 throw std::runtime_error{"not sequence domain"};
-            addEntity(DataPool::IntegerEntityPool.make<XIntegerValue>(top = v));
+            add(v, v);
         }
 
         void addInterval(int min, int max) {
             if (min >= max || min <= top)
                 throw std::runtime_error{"not sequence domain"};
-            addEntity(DataPool::IntegerEntityPool.make<XIntegerInterval>(min, top = max));
+            add(min, max);
         }
 
         friend std::ostream& operator<<(std::ostream& f, const XDomainInteger& d);
 
-        bool equals(XDomainInteger* arg) const {
-            if (nbValues() != arg->nbValues())
-                return false;
-            if (values.size() != arg->values.size())
-                return false;
-            for (unsigned int i = 0; i < arg->values.size(); i++) {
-                if (values[i]->equals(arg->values[i]) == false)
-                    return false;
-            }
-            return true;
+        // true if the two domains have the same values
+        bool equals(const XDomainInteger* arg) const;
+
+        // a hash of the values, the same for two equal domains
+        uint32_t hash() const;
+
+        // the same values as another domain
+        void assign(const XDomainInteger& other);
+
+        // remove all the values (the memory is kept)
+        void clear();
+    };
+
+    /**
+     * The domains of an instance, each one stored once: the variables with the same values have the
+     * same domain, and two domains of the table are equal iff they are the same object. The domains
+     * are numbered (XDomainInteger::id) in the order in which they are added.
+     */
+    class XDomainTable {
+        std::vector<XDomainInteger*> slots; // open addressing on the hash of the values, the size is a power of two
+        size_t count;
+
+        void rehash();
+
+    public:
+        XDomainTable() : count(0) {}
+
+        // the domain of the table with the same values as domain, made in the pool if there is none
+        XDomainInteger* intern(const XDomainInteger& domain);
+
+        size_t size() const {
+            return count;
         }
 
+        // remove all the domains, the memory is kept
+        void clear();
     };
 } // namespace XCSP3Core
 
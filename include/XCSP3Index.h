@@ -0,0 +1,92 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3INDEX_H
+#define XCSP3INDEX_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace XCSP3Core {
+
+    /**
+     * The byte ranges of the main elements of an instance, found by a quick scan of the
+     * raw bytes (no XML tree, no callback): the <instance> element, its children
+     * (<variables>, <constraints>, <objectives>, <annotations>) and the top-level children
+     * of <constraints> (constraints, <group>, <block>, <slide>...).
+     *
+     * The index can be saved in a side file and loaded later. With it,
+     * XCSP3CoreParser::parse(filename, index, select) re-parses only the selected
+     * constraints of the file.
+     */
+    class XCSP3Index {
+    public:
+        struct Entry {
+            int level;           // 0 for <instance>, 1 for its children, 2 for the children of <constraints>
+            std::string tag;     // name of the element
+            std::string id;      // attribute id (empty if none)
+            std::string classes; // attribute class (empty if none)
+            size_t begin;        // offset of the '<' of the start tag
+            size_t contentBegin; // offset just after the start tag
+            size_t contentEnd;   // offset of the '<' of the end tag (contentBegin if the element is empty)
+            size_t end;          // offset just after the end tag
+        };
+
+        typedef std::function<bool(const Entry&)> Filter;
+
+        size_t size; // size in bytes of the indexed document
+        std::vector<Entry> entries; // in document order
+
+        XCSP3Index() : size(0) {}
+
+        /**
+         * Scan the document. Throw an exception if its elements are not properly nested.
+         */
+        static XCSP3Index build(const char* data, size_t size);
+
+        /**
+         * Save the index in a text file (one entry per line)
+         */
+        void save(const std::string& filename) const;
+
+        /**
+         * Load an index saved by save()
+         */
+        static XCSP3Index load(const std::string& filename);
+
+        /**
+         * Filters selecting the top-level constraints with the given id, class or tag
+         */
+        static Filter withId(const std::string& id);
+
+        static Filter withClass(const std::string& cls);
+
+        static Filter withTag(const std::string& tag);
+    };
+
+} // namespace XCSP3Core
+
+#endif /* XCSP3INDEX_H */
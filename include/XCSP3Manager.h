@@ -29,6 +29,7 @@
 #include "XCSP3Constants.h"
 #include "XCSP3Constraint.h"
 #include "XCSP3Objective.h"
+#include "XCSP3Pool.h"
 #include "XCSP3Variable.h"
 #include <XCSP3CoreCallbacks.h>
 #include <map>
@@ -42,7 +43,7 @@ namespace XCSP3Core {
 
     public:
         XCSP3CoreCallbacksBase* callback;
-        std::map<std::string, XEntity*>& mapping;
+        XEntityTable& mapping;
         std::string blockClasses;
 
         inline bool discardedClasses(std::string classes) {
@@ -50,23 +51,37 @@ namespace XCSP3Core {
         }
 
     private:
-        std::vector<XCSP3Core::PrimitivePattern*> patterns;
+        std::vector<XCSP3Core::PrimitivePattern*> patterns; // created once, kept from one parse to the next
+        DataPool patternNodes;                              // the nodes of their trees
         bool recognizePrimitives(std::string id, Tree* tree);
         void createPrimitivePatterns();
         void destroyPrimitivePatterns();
 
         void containsTrees(std::vector<XVariable*>& list, std::vector<Tree*>& newlist);
 
+        uint32_t nbVariables;                 // the number of variables built, the next handle
+        std::vector<uint32_t> handles, others; // the lists given to the callbacks with handles
+
+        // true if useHandles and all the elements of list are variables, whose handles are put in result
+        bool toHandles(const std::vector<XVariable*>& list, std::vector<uint32_t>& result);
+
     public:
-        // XCSP3CoreCallbacksBase *c, std::map<std::string, XEntity *> &m, bool
-        XCSP3Manager(XCSP3CoreCallbacksBase* c, std::map<std::string, XEntity*>& m, bool = true) : callback(c), mapping(m), blockClasses("") {}
+        // XCSP3CoreCallbacksBase *c, XEntityTable &m, bool
+        XCSP3Manager(XCSP3CoreCallbacksBase* c, XEntityTable& m, bool = true) : callback(c), mapping(m), blockClasses(""), nbVariables(0) {}
+
+        // The methods called by XMLParser while parsing the constraints are virtual:
+        // they can be recorded and replayed later (see XCSP3RecordingManager)
+        virtual ~XCSP3Manager() {
+            destroyPrimitivePatterns();
+        }
 
-        void beginInstance(InstanceType type) {
+        virtual void beginInstance(InstanceType type) {
             callback->_arguments = nullptr;
+            nbVariables = 0;
             callback->beginInstance(type);
         }
 
-        void endInstance() {
+        virtual void endInstance() {
             callback->endInstance();
         }
 
@@ -90,23 +105,21 @@ namespace XCSP3Core {
 
         void buildVariableArray(XVariableArray* variable);
 
-        void beginConstraints() {
-            if (callback->recognizeSpecialIntensionCases)
+        virtual void beginConstraints() {
+            if (callback->recognizeSpecialIntensionCases && patterns.empty())
                 createPrimitivePatterns();
             callback->beginConstraints();
         }
 
-        void endConstraints() {
+        virtual void endConstraints() {
             callback->endConstraints();
-            if (callback->recognizeSpecialIntensionCases)
-                destroyPrimitivePatterns();
         }
 
-        void beginSlide(std::string id, bool circular) {
+        virtual void beginSlide(std::string id, bool circular) {
             callback->beginSlide(id, circular);
         }
 
-        void endSlide() {
+        virtual void endSlide() {
             callback->endSlide();
         }
 
@@ -129,37 +142,37 @@ namespace XCSP3Core {
         // Basic constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintExtension(XConstraintExtension* constraint);
+        virtual void newConstraintExtension(XConstraintExtension* constraint);
 
         void newConstraintExtensionAsLastOne(XConstraintExtension* constraint);
 
-        void newConstraintIntension(XConstraintIntension* constraint);
+        virtual void newConstraintIntension(XConstraintIntension* constraint);
 
         //--------------------------------------------------------------------------------------
         // Languages constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintRegular(XConstraintRegular* constraint);
+        virtual void newConstraintRegular(XConstraintRegular* constraint);
 
-        void newConstraintMDD(XConstraintMDD* constraint);
+        virtual void newConstraintMDD(XConstraintMDD* constraint);
 
         //--------------------------------------------------------------------------------------
         // Comparison constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintAllDiff(XConstraintAllDiff* constraint);
+        virtual void newConstraintAllDiff(XConstraintAllDiff* constraint);
 
-        void newConstraintAllDiffMatrix(XConstraintAllDiffMatrix* constraint);
+        virtual void newConstraintAllDiffMatrix(XConstraintAllDiffMatrix* constraint);
 
-        void newConstraintAllDiffList(XConstraintAllDiffList* constraint);
+        virtual void newConstraintAllDiffList(XConstraintAllDiffList* constraint);
 
-        void newConstraintAllEqual(XConstraintAllEqual* constraint);
+        virtual void newConstraintAllEqual(XConstraintAllEqual* constraint);
 
-        void newConstraintOrdered(XConstraintOrdered* constraint);
+        virtual void newConstraintOrdered(XConstraintOrdered* constraint);
 
-        void newConstraintLex(XConstraintLex* constraint);
+        virtual void newConstraintLex(XConstraintLex* constraint);
 
-        void newConstraintLexMatrix(XConstraintLexMatrix* constraint);
+        virtual void newConstraintLexMatrix(XConstraintLexMatrix* constraint);
 
         //--------------------------------------------------------------------------------------
         // Summin and Counting constraints
@@ -168,64 +181,64 @@ namespace XCSP3Core {
         void normalizeSum(std::vector<XVariable*>& list, std::vector<int>& coefs);
 
     public:
-        void newConstraintSum(XConstraintSum* constraint);
+        virtual void newConstraintSum(XConstraintSum* constraint);
 
-        void newConstraintCount(XConstraintCount* constraint);
+        virtual void newConstraintCount(XConstraintCount* constraint);
 
-        void newConstraintNValues(XConstraintNValues* constraint);
+        virtual void newConstraintNValues(XConstraintNValues* constraint);
 
-        void newConstraintCardinality(XConstraintCardinality* constraint);
+        virtual void newConstraintCardinality(XConstraintCardinality* constraint);
 
         //--------------------------------------------------------------------------------------
         // Connection constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintMinimum(XConstraintMinimum* constraint);
+        virtual void newConstraintMinimum(XConstraintMinimum* constraint);
 
-        void newConstraintMaximum(XConstraintMaximum* constraint);
+        virtual void newConstraintMaximum(XConstraintMaximum* constraint);
 
-        void newConstraintElement(XConstraintElement* constraint);
+        virtual void newConstraintElement(XConstraintElement* constraint);
 
-        void newConstraintElementMatrix(XConstraintElementMatrix* constraint);
+        virtual void newConstraintElementMatrix(XConstraintElementMatrix* constraint);
 
-        void newConstraintChannel(XConstraintChannel* constraint);
+        virtual void newConstraintChannel(XConstraintChannel* constraint);
         //--------------------------------------------------------------------------------------
         // packing and scheduling constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintStretch(XConstraintStretch* constraint);
+        virtual void newConstraintStretch(XConstraintStretch* constraint);
 
-        void newConstraintNoOverlap(XConstraintNoOverlap* constraint);
+        virtual void newConstraintNoOverlap(XConstraintNoOverlap* constraint);
 
         void newConstraintNoOverlapKDim(XConstraintNoOverlap* constraint);
 
-        void newConstraintCumulative(XConstraintCumulative* constraint);
+        virtual void newConstraintCumulative(XConstraintCumulative* constraint);
 
         //--------------------------------------------------------------------------------------
         // Instantiation  constraint
         //--------------------------------------------------------------------------------------
-        void newConstraintInstantiation(XConstraintInstantiation* constraint);
+        virtual void newConstraintInstantiation(XConstraintInstantiation* constraint);
 
         //--------------------------------------------------------------------------------------
         // Clause  constraint
         //--------------------------------------------------------------------------------------
-        void newConstraintClause(XConstraintClause* constraint);
+        virtual void newConstraintClause(XConstraintClause* constraint);
 
         //--------------------------------------------------------------------------------------
         // Graph  constraints
         //--------------------------------------------------------------------------------------
 
-        void newConstraintCircuit(XConstraintCircuit* constraint);
+        virtual void newConstraintCircuit(XConstraintCircuit* constraint);
 
         //--------------------------------------------------------------------------------------
         // block of  constraints
         //--------------------------------------------------------------------------------------
-        void beginBlock(std::string classes) {
+        virtual void beginBlock(std::string classes) {
             blockClasses = classes;
             callback->beginBlock(classes);
         }
 
-        void endBlock() {
+        virtual void endBlock() {
             blockClasses = "";
             callback->endBlock();
         }
@@ -234,18 +247,18 @@ namespace XCSP3Core {
         // group constraints
         //--------------------------------------------------------------------------------------
 
-        void beginGroup(std::string id) {
+        virtual void beginGroup(std::string id) {
             callback->beginGroup(id);
         }
 
-        void endGroup() {
+        virtual void endGroup() {
             callback->endGroup();
         }
 
         template <class T>
         void unfoldConstraint(XConstraintGroup* group, int i, void (XCSP3Manager::*newConstraint)(T*));
 
-        void newConstraintGroup(XConstraintGroup* group);
+        virtual void newConstraintGroup(XConstraintGroup* group);
 
         //--------------------------------------------------------------------------------------
         // Objective constraints
@@ -258,7 +271,10 @@ namespace XCSP3Core {
         //--------------------------------------------------------------------------------------
 
         void buildAnnotationDecision(std::vector<XVariable*>& list) {
-            callback->buildAnnotationDecision(list);
+            if (toHandles(list, handles))
+                callback->buildAnnotationDecision(XHandles(handles.data(), handles.size()));
+            else
+                callback->buildAnnotationDecision(list);
         }
     };
 
@@ -0,0 +1,68 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3PARSERSESSION_H
+#define XCSP3PARSERSESSION_H
+
+#include "XCSP3CoreParser.h"
+
+namespace XCSP3Core {
+
+    /**
+     * @brief a parser made to parse many instances in a row
+     *
+     * Between two parses, a session keeps what does not depend on the instance: the tag actions
+     * and the primitive patterns (as any parser), the libxml2 parser context, the buffer used to
+     * read streams and the memory of the pools. Only the objects of the previous instance are
+     * destroyed. The callbacks can be changed between two parses.
+     */
+    class XCSP3ParserSession : public XCSP3CoreParser {
+    public:
+        XCSP3ParserSession(XCSP3CoreCallbacksBase* cb) : XCSP3CoreParser(cb) {
+            warm = true;
+        }
+
+        /**
+         * The callbacks of the next parses
+         */
+        void setCallbacks(XCSP3CoreCallbacksBase* cb) {
+            cspParser.manager->callback = cb;
+        }
+
+        /**
+         * Release the memory kept for the next parses
+         */
+        void shrink() {
+            cspParser.pool.clear();
+            readBuffer.reset();
+            if (context != nullptr) {
+                xmlFreeParserCtxt(context);
+                context = nullptr;
+            }
+        }
+    };
+
+} // namespace XCSP3Core
+
+#endif // XCSP3PARSERSESSION_H
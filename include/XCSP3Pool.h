@@ -1,35 +1,180 @@
 #ifndef XPOOL_H
 #define XPOOL_H
 
-#include <vector>
-#include <memory>
+#include "XCSP3Symbol.h"
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
 #include <utility>
-#include <iostream>
-#include <typeinfo>
+#include <vector>
 
 namespace XCSP3Core {
 
+    /**
+     * Memory allocated by slabs: an allocation moves a pointer within the current slab,
+     * and the memory is only released all at once.
+     */
+    class Arena {
+        struct Slab {
+            char* memory;
+            size_t size;
+            bool mapped; // allocated with mmap (huge pages), not with new
+        };
+
+        std::vector<Slab> slabs;
+        size_t current;  // the slab being filled
+        char *next, *end; // the free part of this slab
+
+        void* grow(size_t size, size_t alignment);
+
+    public:
+        bool hugePages; // if true, slabs are large and advised to be backed by huge pages
+
+        Arena() : current(0), next(nullptr), end(nullptr), hugePages(false) {}
+
+        ~Arena() {
+            release();
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        void* allocate(size_t size, size_t alignment) {
+            uintptr_t p = (reinterpret_cast<uintptr_t>(next) + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            if (next != nullptr && p + size <= reinterpret_cast<uintptr_t>(end)) {
+                next = reinterpret_cast<char*>(p + size);
+                return reinterpret_cast<void*>(p);
+            }
+            return grow(size, alignment);
+        }
+
+        // the memory can be allocated again, the slabs are kept
+        void rewind();
+
+        // give the slabs back to the system
+        void release();
+
+        // forget the slabs without giving them back (the process is about to exit)
+        void abandon();
+
+        void swap(Arena& other);
+    };
+
+    /**
+     * The objects of a base type Data, allocated in an arena. The objects whose type
+     * is not trivially destructible are destroyed, in the reverse order of their
+     * creation, when the pool is cleared, reset or destroyed.
+     */
     template<typename Data>
-    struct Pool {
-        std::vector<std::unique_ptr<Data>> pool_;
+    class Pool {
+        // written in the arena next to each object to destroy
+        struct Destructor {
+            void* object;
+            void (*destroy)(void*);
+            Destructor* previous;
+        };
 
-        template <typename T, typename... U>
-        T* make(U&&... us) {
-            pool_.emplace_back(new T(std::forward<U>(us)...));
-            return static_cast<T*>(pool_.back().get());
+        Arena arena;
+        Destructor* last; // the destructor of the last object to destroy
+
+        template <typename T>
+        static void destroy(void* object) {
+            static_cast<T*>(object)->~T();
+        }
+
+        void destroyAll() {
+            for (; last != nullptr; last = last->previous)
+                last->destroy(last->object);
         }
 
+    public:
+        Pool() : last(nullptr) {}
+
         ~Pool() {
-            // std::cout << typeid(Data).name() << " : " << pool_.size() << " freed from pool" << std::endl;
+            destroyAll();
+        }
+
+        Pool(const Pool&) = delete;
+        Pool& operator=(const Pool&) = delete;
+
+        template <typename T, typename... U>
+        T* make(U&&... us) {
+            T* object = new (arena.allocate(sizeof(T), alignof(T))) T(std::forward<U>(us)...);
+            if (!std::is_trivially_destructible<T>::value)
+                last = new (arena.allocate(sizeof(Destructor), alignof(Destructor))) Destructor{object, &Pool::destroy<T>, last};
+            return object;
         }
 
+        // destroy the objects and release the memory
         void clear() {
-            pool_.clear();
+            destroyAll();
+            arena.release();
+        }
+
+        // destroy the objects, the memory is kept for the next objects
+        void reset() {
+            destroyAll();
+            arena.rewind();
+        }
+
+        // forget the objects, without destroying them nor releasing their memory
+        void leak() {
+            last = nullptr;
+            arena.abandon();
+        }
+
+        void useHugePages(bool hugePages) {
+            arena.hugePages = hugePages;
         }
 
         void swap(Pool& other) {
-            pool_.swap(other.pool_);
+            arena.swap(other.arena);
+            std::swap(last, other.last);
+        }
+    };
+
+    /**
+     * The names of the symbols, each one stored once in an arena, and found
+     * by an open addressing hash table
+     */
+    class SymbolTable {
+        Arena names;
+        std::vector<const char*> slots; // nullptr if free, the size is a power of two
+        size_t count;
+
+        void rehash();
+
+    public:
+        SymbolTable() : count(0) {}
+
+        SymbolTable(const SymbolTable&) = delete;
+        SymbolTable& operator=(const SymbolTable&) = delete;
+
+        // the symbol of this name, added to the table if needed
+        Symbol intern(const char* name, size_t size);
+
+        Symbol intern(const std::string& name) {
+            return intern(name.data(), name.size());
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        void clear();
+
+        void reset();
+
+        void leak();
+
+        void useHugePages(bool hugePages) {
+            names.hugePages = hugePages;
         }
+
+        void swap(SymbolTable& other);
     };
 
     class XEntity;
@@ -39,15 +184,82 @@ namespace XCSP3Core {
     class XObjective;
     class Node;
 
-    struct DataPool {
-        static Pool<XEntity> EntityPool;
-        static Pool<XIntegerEntity> IntegerEntityPool;
-        static Pool<XDomain> DomainPool;
-        static Pool<XConstraint> ConstraintPool;
-        static Pool<XObjective> ObjectivePool;
-        static Pool<Node> NodePool;
+    /**
+     * The objects allocated while parsing an instance. Each parser owns its pools and makes them
+     * the current pools of its thread while it parses (see Scope): two parsers never share their
+     * objects, whether they run in the same thread or not.
+     */
+    class DataPool {
+    public:
+        Pool<XEntity> EntityPool;
+        Pool<XIntegerEntity> IntegerEntityPool;
+        Pool<XDomain> DomainPool;
+        Pool<XConstraint> ConstraintPool;
+        Pool<XObjective> ObjectivePool;
+        Pool<Node> NodePool;
+        SymbolTable symbols; // the ids of the entities, constraints and tree variables
+
+        // The cells of the arrays, created when they are first referenced, possibly by the workers
+        // of a parallel parse: they are created apart from the other objects, and under the lock
+        // while sharedCells is set (that is, while the workers run)
+        Pool<XEntity> CellPool;
+        SymbolTable cellSymbols;
+        std::mutex cellMutex;
+        bool sharedCells;
+
+        DataPool();
+        ~DataPool();
+
+        DataPool(const DataPool&) = delete;
+        DataPool& operator=(const DataPool&) = delete;
+
+        // destroy all the objects, and release the memory of the pools
+        void clear();
+
+        // destroy all the objects, but keep the memory of the pools for the next objects
+        void reset();
+
+        // forget all the objects, without destroying them nor releasing their memory:
+        // for programs which exit right after the parse
+        void leak();
+
+        // allocate the next objects in large slabs advised to be backed by huge pages
+        void useHugePages(bool hugePages);
+
+        // exchange the objects of the two pools
+        void swap(DataPool& other);
+
+        /**
+         * The pools of the parse in progress in the calling thread. Outside any parse
+         * (trees built by the user for instance), pools owned by the thread.
+         */
+        static DataPool& current() {
+            return current_ != nullptr ? *current_ : threadPool();
+        }
+
+        /**
+         * Make pools the current ones of the calling thread, until the end of the scope
+         */
+        class Scope {
+            DataPool* previous;
+
+        public:
+            explicit Scope(DataPool& pool) : previous(current_) {
+                current_ = &pool;
+            }
+
+            ~Scope() {
+                current_ = previous;
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+        };
+
+    private:
+        static thread_local DataPool* current_;
 
-        static void clear();
+        static DataPool& threadPool();
     };
 
 }
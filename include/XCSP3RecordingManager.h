@@ -0,0 +1,153 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3RECORDINGMANAGER_H
+#define XCSP3RECORDINGMANAGER_H
+
+#include "XCSP3Manager.h"
+#include <functional>
+#include <vector>
+
+namespace XCSP3Core {
+
+    /**
+     * A manager which records the constraints given by XMLParser instead of handing them
+     * to the callbacks. The calls are replayed later, possibly by another thread, on the
+     * real manager. The constraints must stay alive until then (see DataPool::swap).
+     *
+     * The beginning and the end of the instance and of the constraints are not recorded:
+     * the recorded document only holds a part of the constraints of an instance.
+     */
+    class XCSP3RecordingManager : public XCSP3Manager {
+    public:
+        typedef std::function<void(XCSP3Manager&)> Call;
+
+        std::vector<Call> calls;
+
+        XCSP3RecordingManager(XCSP3CoreCallbacksBase* c, XEntityTable& m) : XCSP3Manager(c, m) {}
+
+        /**
+         * Replay the recorded calls on the given manager, in the recorded order
+         */
+        void replay(XCSP3Manager& manager) {
+            for (Call& call : calls)
+                call(manager);
+        }
+
+        void beginInstance(InstanceType) override {}
+
+        void endInstance() override {}
+
+        void beginConstraints() override {}
+
+        void endConstraints() override {}
+
+        void beginSlide(std::string id, bool circular) override {
+            calls.push_back([id, circular](XCSP3Manager& m) { m.beginSlide(id, circular); });
+        }
+
+        void endSlide() override {
+            calls.push_back([](XCSP3Manager& m) { m.endSlide(); });
+        }
+
+        void beginBlock(std::string classes) override {
+            calls.push_back([classes](XCSP3Manager& m) { m.beginBlock(classes); });
+        }
+
+        void endBlock() override {
+            calls.push_back([](XCSP3Manager& m) { m.endBlock(); });
+        }
+
+        void beginGroup(std::string id) override {
+            calls.push_back([id](XCSP3Manager& m) { m.beginGroup(id); });
+        }
+
+        void endGroup() override {
+            calls.push_back([](XCSP3Manager& m) { m.endGroup(); });
+        }
+
+        void newConstraintGroup(XConstraintGroup* c) override { record(&XCSP3Manager::newConstraintGroup, c); }
+
+        void newConstraintExtension(XConstraintExtension* c) override { record(&XCSP3Manager::newConstraintExtension, c); }
+
+        void newConstraintIntension(XConstraintIntension* c) override { record(&XCSP3Manager::newConstraintIntension, c); }
+
+        void newConstraintRegular(XConstraintRegular* c) override { record(&XCSP3Manager::newConstraintRegular, c); }
+
+        void newConstraintMDD(XConstraintMDD* c) override { record(&XCSP3Manager::newConstraintMDD, c); }
+
+        void newConstraintAllDiff(XConstraintAllDiff* c) override { record(&XCSP3Manager::newConstraintAllDiff, c); }
+
+        void newConstraintAllDiffMatrix(XConstraintAllDiffMatrix* c) override { record(&XCSP3Manager::newConstraintAllDiffMatrix, c); }
+
+        void newConstraintAllDiffList(XConstraintAllDiffList* c) override { record(&XCSP3Manager::newConstraintAllDiffList, c); }
+
+        void newConstraintAllEqual(XConstraintAllEqual* c) override { record(&XCSP3Manager::newConstraintAllEqual, c); }
+
+        void newConstraintOrdered(XConstraintOrdered* c) override { record(&XCSP3Manager::newConstraintOrdered, c); }
+
+        void newConstraintLex(XConstraintLex* c) override { record(&XCSP3Manager::newConstraintLex, c); }
+
+        void newConstraintLexMatrix(XConstraintLexMatrix* c) override { record(&XCSP3Manager::newConstraintLexMatrix, c); }
+
+        void newConstraintSum(XConstraintSum* c) override { record(&XCSP3Manager::newConstraintSum, c); }
+
+        void newConstraintCount(XConstraintCount* c) override { record(&XCSP3Manager::newConstraintCount, c); }
+
+        void newConstraintNValues(XConstraintNValues* c) override { record(&XCSP3Manager::newConstraintNValues, c); }
+
+        void newConstraintCardinality(XConstraintCardinality* c) override { record(&XCSP3Manager::newConstraintCardinality, c); }
+
+        void newConstraintMinimum(XConstraintMinimum* c) override { record(&XCSP3Manager::newConstraintMinimum, c); }
+
+        void newConstraintMaximum(XConstraintMaximum* c) override { record(&XCSP3Manager::newConstraintMaximum, c); }
+
+        void newConstraintElement(XConstraintElement* c) override { record(&XCSP3Manager::newConstraintElement, c); }
+
+        void newConstraintElementMatrix(XConstraintElementMatrix* c) override { record(&XCSP3Manager::newConstraintElementMatrix, c); }
+
+        void newConstraintChannel(XConstraintChannel* c) override { record(&XCSP3Manager::newConstraintChannel, c); }
+
+        void newConstraintStretch(XConstraintStretch* c) override { record(&XCSP3Manager::newConstraintStretch, c); }
+
+        void newConstraintNoOverlap(XConstraintNoOverlap* c) override { record(&XCSP3Manager::newConstraintNoOverlap, c); }
+
+        void newConstraintCumulative(XConstraintCumulative* c) override { record(&XCSP3Manager::newConstraintCumulative, c); }
+
+        void newConstraintInstantiation(XConstraintInstantiation* c) override { record(&XCSP3Manager::newConstraintInstantiation, c); }
+
+        void newConstraintClause(XConstraintClause* c) override { record(&XCSP3Manager::newConstraintClause, c); }
+
+        void newConstraintCircuit(XConstraintCircuit* c) override { record(&XCSP3Manager::newConstraintCircuit, c); }
+
+    private:
+        template <class T>
+        void record(void (XCSP3Manager::*newConstraint)(T*), T* constraint) {
+            calls.push_back([newConstraint, constraint](XCSP3Manager& m) { (m.*newConstraint)(constraint); });
+        }
+    };
+
+} // namespace XCSP3Core
+
+#endif /* XCSP3RECORDINGMANAGER_H */
@@ -0,0 +1,224 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XCSP3SYMBOL_H
+#define XCSP3SYMBOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+
+namespace XCSP3Core {
+
+    /**
+     * @brief the id of an entity (variable, constraint...), interned in the symbol table of the
+     * current pools (see DataPool)
+     *
+     * A symbol is only a pointer to the characters of the name, stored once by the table:
+     * copying it costs nothing, and two symbols of the same table are equal iff they point
+     * to the same name. A symbol converts to std::string, so that it can be used as before
+     * in place of a std::string. It lives as long as the pools of the parse it comes from.
+     */
+    class Symbol {
+        friend class SymbolTable;
+
+        /**
+         * The header written by the table before the characters of a name,
+         * which are followed by a null character
+         */
+        struct Header {
+            uint32_t hash;
+            uint32_t size;
+        };
+
+        const char* name;
+
+        struct Interned {};
+
+        Symbol(Interned, const char* interned) : name(interned) {}
+
+        static Symbol at(const char* interned) {
+            return Symbol(Interned(), interned);
+        }
+
+        Header header() const {
+            Header h;
+            memcpy(&h, name - sizeof(Header), sizeof(Header));
+            return h;
+        }
+
+        static const char* emptyName();
+
+    public:
+        Symbol() : name(emptyName()) {}
+
+        Symbol(const std::string& s);
+
+        Symbol(const char* s);
+
+        std::string str() const {
+            return std::string(name, size());
+        }
+
+        operator std::string() const {
+            return str();
+        }
+
+        // the same pointer for all the symbols of a table equal to this one
+        const void* handle() const {
+            return name;
+        }
+
+        const char* c_str() const {
+            return name;
+        }
+
+        const char* data() const {
+            return name;
+        }
+
+        size_t size() const {
+            return header().size;
+        }
+
+        size_t length() const {
+            return header().size;
+        }
+
+        bool empty() const {
+            return header().size == 0;
+        }
+
+        size_t hash() const {
+            return header().hash;
+        }
+
+        char operator[](size_t i) const {
+            return name[i];
+        }
+
+        std::string substr(size_t pos = 0, size_t n = std::string::npos) const {
+            return str().substr(pos, n);
+        }
+
+        size_t find(const std::string& s, size_t pos = 0) const {
+            return str().find(s, pos);
+        }
+
+        size_t rfind(const std::string& s, size_t pos = std::string::npos) const {
+            return str().rfind(s, pos);
+        }
+
+        bool equals(const char* s, size_t n) const {
+            return size() == n && memcmp(name, s, n) == 0;
+        }
+
+        int compare(const Symbol& other) const {
+            if (name == other.name)
+                return 0;
+            size_t n = size() < other.size() ? size() : other.size();
+            int c = memcmp(name, other.name, n);
+            return c != 0 ? c : (size() < other.size() ? -1 : size() > other.size() ? 1 : 0);
+        }
+
+        // the hash of a name, as computed by the tables
+        static uint32_t hash(const char* s, size_t n) {
+            uint32_t h = 2166136261u;
+            for (size_t i = 0; i < n; i++)
+                h = (h ^ static_cast<unsigned char>(s[i])) * 16777619u;
+            return h;
+        }
+
+        friend bool operator==(const Symbol& a, const Symbol& b) {
+            return a.name == b.name || (a.hash() == b.hash() && a.equals(b.name, b.size()));
+        }
+
+        friend bool operator==(const Symbol& a, const std::string& b) {
+            return a.equals(b.data(), b.size());
+        }
+
+        friend bool operator==(const std::string& a, const Symbol& b) {
+            return b.equals(a.data(), a.size());
+        }
+
+        friend bool operator==(const Symbol& a, const char* b) {
+            return a.equals(b, strlen(b));
+        }
+
+        friend bool operator!=(const Symbol& a, const Symbol& b) {
+            return !(a == b);
+        }
+
+        friend bool operator!=(const Symbol& a, const std::string& b) {
+            return !(a == b);
+        }
+
+        friend bool operator!=(const std::string& a, const Symbol& b) {
+            return !(a == b);
+        }
+
+        friend bool operator!=(const Symbol& a, const char* b) {
+            return !(a == b);
+        }
+
+        friend bool operator<(const Symbol& a, const Symbol& b) {
+            return a.compare(b) < 0;
+        }
+
+        friend std::string operator+(const Symbol& a, const std::string& b) {
+            return a.str() + b;
+        }
+
+        friend std::string operator+(const std::string& a, const Symbol& b) {
+            return a + b.str();
+        }
+
+        friend std::string operator+(const Symbol& a, const char* b) {
+            return a.str() + b;
+        }
+
+        friend std::string operator+(const char* a, const Symbol& b) {
+            return a + b.str();
+        }
+
+        friend std::ostream& operator<<(std::ostream& f, const Symbol& s) {
+            return f.write(s.name, s.size());
+        }
+    };
+
+} // namespace XCSP3Core
+
+namespace std {
+    template <>
+    struct hash<XCSP3Core::Symbol> {
+        size_t operator()(const XCSP3Core::Symbol& s) const {
+            return s.hash();
+        }
+    };
+} // namespace std
+
+#endif // XCSP3SYMBOL_H
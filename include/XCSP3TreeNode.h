@@ -26,6 +26,7 @@
 #ifndef XCSP3PARSER_XCSP3TREENODE_H
 #define XCSP3PARSER_XCSP3TREENODE_H
 
+#include "XCSP3Symbol.h"
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -167,7 +168,7 @@ namespace XCSP3Core {
     class NodeVariable : public Node {
 
     public:
-        std::string var;
+        Symbol var;
 
         NodeVariable(std::string v) : Node(Expr::VAR), var(v) {}
 
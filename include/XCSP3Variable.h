@@ -26,6 +26,8 @@
 #define XVARIABLE_H
 
 #include "XCSP3Domain.h"
+#include <cstdint>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -40,7 +42,7 @@ namespace XCSP3Core {
 
     class XEntity {
     public:
-        std::string id;
+        Symbol id;
 
         XEntity();
         XEntity(std::string lid);
@@ -51,15 +53,54 @@ namespace XCSP3Core {
 
     class XVariable : public XEntity {
     public:
+        static const uint32_t NO_HANDLE = UINT32_MAX;
+
         std::string classes;
         XDomainInteger* domain;
+        uint32_t handle; // the number of the variable, in the order of the declarations (NO_HANDLE if not built)
 
         XVariable(std::string idd, XDomainInteger* dom);
-        XVariable(std::string idd, XDomainInteger* dom, std::vector<int> indexes);
+        XVariable(Symbol idd, XDomainInteger* dom, uint32_t h);
         virtual ~XVariable();
         friend std::ostream& operator<<(std::ostream& f, const XVariable& ie);
     };
 
+    /**
+     * A view of the handles of a list of variables (see XVariable::handle),
+     * valid during the call of the callback which receives it
+     */
+    class XHandles {
+        const uint32_t* first;
+        size_t count;
+
+    public:
+        XHandles(const uint32_t* f, size_t n) : first(f), count(n) {}
+
+        const uint32_t* data() const {
+            return first;
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        uint32_t operator[](size_t i) const {
+            return first[i];
+        }
+
+        const uint32_t* begin() const {
+            return first;
+        }
+
+        const uint32_t* end() const {
+            return first + count;
+        }
+    };
+
     /*
          * This is a fake variable used for representing an integer
          */
@@ -101,50 +142,147 @@ namespace XCSP3Core {
      */
     class XParameterVariable : public XVariable {
     public:
-        static int max; // Max parameter number for current group
         int number;     // -1 if %...
         XParameterVariable(std::string lid);
     };
 
+    /**
+     * An array of variables. Its cells are not built with the array: the array knows the domain of each
+     * cell, and a cell is created the first time it is referenced (see variableAt). The arrays declared
+     * "as" another one share its domains.
+     */
     class XVariableArray : public XEntity {
+        // The domains of the cells, shared by the arrays declared "as" this one
+        struct Domains {
+            struct Rule { // <domain for="x[a..b][c]...">: the cells from first to last in each dimension
+                std::vector<int> first, last;
+                XDomainInteger* domain;
+            };
+
+            XDomainInteger* others;              // the domain of the cells given by no rule, NULL if there are none
+            std::vector<Rule> rules;             // in the order of the document: the last one matching a cell applies
+            std::vector<XDomainInteger*> cells;  // the domain of each cell, instead of the rules when there are many
+
+            Domains() : others(NULL) {}
+        };
+
+        // The handles given to consecutive cells
+        struct HandleRun {
+            size_t flat;
+            uint32_t handle;
+            size_t count;
+        };
+
+        static const size_t PAGE_SIZE = 256;
+
+        DataPool* owner; // the pools of the parse, which hold the cells
+        size_t nbCells;
+        std::shared_ptr<Domains> domains;
+        std::vector<HandleRun> handles;
+        std::vector<std::unique_ptr<XVariable*[]>> pages; // the created cells, by pages of PAGE_SIZE cells
+
+        Domains& ownDomains(); // the domains, copied first if they are shared
+
+        void rangesFor(const std::string& compactForm, std::vector<int>& first, std::vector<int>& last) const;
+
     public:
         std::string classes;
-        std::vector<XVariable*> variables; // The flat (one-dimensional) array
         std::vector<int> sizes;            // The size of the array, as defined in XCSP3.
 
         /**
-         * Builds an array of variables with the specified id, type and size. 
-         * All variables are directly defined with the specified domain. 
-         *
+         * Builds an array of variables with the specified id and size.
+         * The domains of the cells are given by addDomain and endDomains.
          */
         XVariableArray(std::string id, std::vector<int> szs);
 
         /**
-         * 
-         * Copy constructor 
-         * @param domain
+         * An array with the same size and domains as another one
          */
         XVariableArray(std::string idd, XVariableArray* as);
 
         virtual ~XVariableArray();
 
+        // The number of cells, including those without a domain
+        size_t size() const {
+            return nbCells;
+        }
+
         /** Transforms a flat index 
          * into a multi-dimensional index. 
          */
         void indexesFor(int flatIndex, std::vector<int>& indexes);
 
-        int flatIndexFor(std::vector<int> indexes);
+        int flatIndexFor(const std::vector<int>& indexes);
 
-        bool incrementIndexes(std::vector<int>& indexes, std::vector<XIntegerEntity*>& ranges);
+        bool incrementIndexes(std::vector<int>& indexes, const std::vector<int>& first, const std::vector<int>& last);
 
         /** Returns the list of variables that match the specified compact form. For example, for x[1..3], the list will contain x[1] x[2] and x[3]. */
-        void getVarsFor(std::vector<XVariable*>& list, std::string compactForm, std::vector<int>* flatIndexes = NULL, bool storeIndexes = false);
+        void getVarsFor(std::vector<XVariable*>& list, const std::string& compactForm);
 
-        /** 
-         * Builds a variable with the specified domain 
-         *  for each unoccupied cell of the flat array. 
+        /** Returns the variable of the cell given by its indexes, such as [3][17], NULL if there is none. */
+        XVariable* variableAt(const char* indexes, size_t size);
+
+        /**
+         * Returns the variable of a cell, created the first time, NULL if the cell has no domain or
+         * does not exist. During a parallel parse, the cells are created under the lock of the pool.
+         */
+        XVariable* variableAt(size_t flat);
+
+        /** Gives a domain to the cells that match the specified compact form, such as [2..4][] (<domain for=...>). */
+        void addDomain(const std::string& compactForm, XDomainInteger* domain);
+
+        /**
+         * Gives a domain to the cells which have none, once all the <domain for=...> are known
+         * (NULL: these cells are not variables).
          */
-        void buildVarsWith(XDomainInteger* domain);
+        void endDomains(XDomainInteger* others);
+
+        // The domain of a cell, NULL if it has none
+        XDomainInteger* domainAt(size_t flat) const;
+
+        // The id of a cell, such as x[3][17]
+        void cellId(size_t flat, std::string& name) const;
+
+        // Sets the handle of a cell, announced to the callbacks (the cells are announced in order)
+        void setHandle(size_t flat, uint32_t handle);
+
+        uint32_t handleAt(size_t flat) const;
+    };
+
+    /**
+     * The variables and the arrays of an instance, found by their id. The cells of the arrays are not
+     * in the table: the cell x[i][j] is found by looking for x, then by computing the index of the cell.
+     */
+    class XEntityTable {
+        std::vector<XEntity*> slots; // open addressing on the hash of the ids, the size is a power of two
+        size_t count;
+
+        size_t slotOf(const char* name, size_t size, uint32_t hash) const; // the slot of the entity, or a free one
+        void rehash();
+
+    public:
+        XEntityTable() : count(0) {}
+
+        // add the entity, or replace the one with the same id
+        void add(XEntity* entity);
+
+        // the entity (possibly a cell of an array) with this id, NULL if there is none
+        XEntity* find(const char* name, size_t size) const;
+
+        XEntity* find(const std::string& name) const {
+            return find(name.data(), name.size());
+        }
+
+        XEntity* find(const Symbol& name) const {
+            return find(name.data(), name.size());
+        }
+
+        size_t size() const {
+            return count;
+        }
+
+        // remove all the entities, the memory is kept
+        void clear();
     };
 } // namespace XCSP3Core
 
@@ -27,6 +27,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
 #include <cwctype>
 #include <functional>
 #include <locale>
@@ -55,6 +57,59 @@ namespace XCSP3Core {
     // trim from both ends
     std::string& trim(std::string& s);
 
+    /**
+     * Parse the decimal integer held by the bytes [b, e): an optional sign followed by digits, nothing else.
+     * The conversion does not depend on the locale and is checked for overflows.
+     * Return false (v is left unchanged) if [b, e) is not an integer or if it does not fit in an int.
+     */
+    inline bool parseInt(const char* b, const char* e, int& v) {
+        bool neg = false;
+        if (b != e && (*b == '-' || *b == '+')) {
+            neg = *b == '-';
+            ++b;
+        }
+        if (b == e)
+            return false;
+        while (e - b > 10 && *b == '0') // leading zeros do not count in the length check below
+            ++b;
+        if (e - b > 10)
+            return false;
+
+        uint64_t r = 0;
+#if defined(__BYTE_ORDER__) && defined(__ORDER_LITTLE_ENDIAN__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        if (e - b >= 8) {
+            // Check and convert 8 digits at once (SWAR): the first digit is in the lowest byte
+            uint64_t chunk;
+            memcpy(&chunk, b, sizeof(chunk));
+            if ((((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))) !=
+                0x3333333333333333ULL)
+                return false;
+            chunk -= 0x3030303030303030ULL;
+            chunk = (chunk * 10) + (chunk >> 8);
+            r = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+                 (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >>
+                32;
+            b += 8;
+        }
+#endif
+        for (; b != e; ++b) {
+            unsigned int d = static_cast<unsigned char>(*b) - static_cast<unsigned int>('0');
+            if (d > 9)
+                return false;
+            r = r * 10 + d;
+        }
+        if (r > (neg ? 2147483648ULL : 2147483647ULL))
+            return false;
+        v = neg ? static_cast<int>(-static_cast<int64_t>(r)) : static_cast<int>(r);
+        return true;
+    }
+
+    /**
+     * Same as std::stoi, with the strict syntax of parseInt (only white spaces may surround the integer).
+     * Throw std::invalid_argument if s is not an integer and std::out_of_range if it does not fit in an int.
+     */
+    int toInt(const std::string& s);
+
 } // namespace XCSP3Core
 
 #endif /* UTILS_H */
@@ -41,6 +41,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "XCSP3Constants.h"
@@ -48,12 +49,14 @@
 #include "XCSP3Domain.h"
 #include "XCSP3Manager.h"
 #include "XCSP3Objective.h"
+#include "XCSP3Pool.h"
 #include "XCSP3Variable.h"
 #include "XCSP3utils.h"
 #include "XCSP3Pool.h"
 
 #include "AttributeList.h"
 #include "UTF8String.h"
+#include "XMLTags.h"
 
 /**
  * @namespace CSPXMLParser
@@ -72,9 +75,12 @@ namespace XCSP3Core {
      */
     class XMLParser {
     public:
+        // the objects (variables, domains, constraints...) built while parsing, see DataPool::Scope
+        DataPool pool;
+
         // list of attributes and values for a tag
-        std::map<std::string, XEntity*> variablesList;
-        std::vector<XDomainInteger*> allDomains;
+        XEntityTable variablesList;
+        XDomainTable domains; // the domains of the variables, each one stored once
         std::vector<XConstraint*> constraints;
         std::unique_ptr<XCSP3Manager> manager;
 
@@ -93,7 +99,13 @@ namespace XCSP3Core {
 
         public:
             std::string tagName;
-            TagAction(XMLParser* parser, std::string name) : parser(parser), tagName(name) { activated = false; }
+            TagType type;
+            bool tupleAware; // true if the text is a list of tuples, which may be split at ')'
+            TagAction(XMLParser* parser, std::string name)
+                : parser(parser), tagName(name), type(tagType(reinterpret_cast<const UTF8String::Byte*>(name.c_str()), name.size())),
+                  tupleAware(false) {
+                activated = false;
+            }
 
             virtual ~TagAction() {}
 
@@ -117,7 +129,7 @@ namespace XCSP3Core {
              */
             // UTF8String txt, bool last
             virtual void text(const UTF8String txt, bool) {
-                if (!txt.isWhiteSpace())
+                if (!this->parser->trusted && !txt.isWhiteSpace())
                     throw std::runtime_error("<" + tagName + "> tag should not have meaningful text");
             }
 
@@ -125,51 +137,37 @@ namespace XCSP3Core {
 
         protected:
             /**
-             * check that the parent tag in the XML file has the indicated name
+             * check that the tag n levels higher in the XML file is of the given type
              *
-             * when name is NULL, check that this tag has no parent in the XML file
-             *
-             * @param parentTag: the expected name of the parent tag or NULL to
-             * check that we have no parent
              * @param n: 1 for parent, 2 for grand-parent and so on
              */
-            void checkParentTag(const char* parentTag, int n = 1) {
-                if (this->parser->getParentTagAction(n) == NULL) {
-                    if (parentTag != NULL)
-                        throw std::runtime_error("tag has no parent but it should have one");
-                    else
-                        return;
-                }
-
-                if (parentTag == NULL)
-                    throw std::runtime_error("tag should have no parent");
-
-#ifdef debug
-                cout << "parent tag="
-                     << this->parser->getParentTagAction(n)->getTagName() << endl;
-#endif
-                if (strcmp(this->parser->getParentTagAction(n)->getTagName(),
-                           parentTag) != 0)
-                    throw std::runtime_error("wrong parent for tag");
+            bool hasParentTag(TagType parentType, int n = 1) {
+                TagAction* parent = this->parser->getParentTagAction(n);
+                return parent != NULL && parent->type == parentType;
             }
         };
 
-        using TagActionList = std::map<UTF8String, std::unique_ptr<TagAction>>;
-        TagActionList tagList;
+        // the tag actions, indexed by tag type
+        std::unique_ptr<TagAction> tagActions[static_cast<int>(TagType::NB)];
+
+        // cache of the tag actions of the names interned by libxml2 (SAX2),
+        // indexed by the address of the name
+        std::unordered_map<const UTF8String::Byte*, TagAction*> internedTagList;
 
         struct State {
+            TagAction* action;
             bool subtagAllowed;
-
-            State() {
-                subtagAllowed = true;
-            }
+            bool tupleAware; // copy of action->tupleAware
         };
 
         class ListTagAction;
 
-        // the top of the following stacks is at the FRONT
-        std::deque<TagAction*> actionStack;
-        std::deque<State> stateStack;
+        // the elements being parsed (XCSP3 documents are shallow): a flat stack
+        // whose top is stack[depth - 1]
+        static const int maxDepth = 64;
+        State stack[maxDepth];
+        int depth;
+
         std::vector<std::vector<XVariable*>> lists;  // used to store Many lists of variables (usefull with lex, channel....)
         std::vector<std::vector<XVariable*>> matrix; // Used in case of matrix tag
         std::vector<std::vector<int>> patterns;
@@ -204,12 +202,13 @@ namespace XCSP3Core {
         std::string start, final;             // used in regular constraint
         std::vector<XTransition> transitions; // used in regular and mdd constraints
         int nbParameters;
+        int maxParameter; // the largest parameter number of the current group
         bool closed;
 
         bool keepIntervals;
 
-        void registerTagAction(TagActionList& tagList, TagAction* action) {
-            tagList[action->getTagName()].reset(action);
+        void registerTagAction(TagAction* action) {
+            tagActions[static_cast<int>(action->type)].reset(action);
         }
 
         /**
@@ -228,6 +227,14 @@ namespace XCSP3Core {
 
         bool parseTuples(const UTF8String& txt, std::vector<std::vector<int>>& tuples);
 
+        static bool parseTuples(const UTF8String& txt, std::vector<std::vector<int>>& tuples, std::vector<int>& tuple);
+
+        /**
+         * Parse a whole list of tuples: the text is split at tuple boundaries in segments
+         * parsed by different threads, then concatenated in order.
+         */
+        bool parseTuplesInParallel(const UTF8String& txt, std::vector<std::vector<int>>& tuples);
+
         /***************************************************************************
              * a handler to silently ignore unkown tags
              ***************************************************************************/
@@ -271,6 +278,7 @@ namespace XCSP3Core {
             XVariable* variable;
             XVariableArray* variableArray;
             XDomainInteger* domain;
+            XDomainInteger parsed; // the domain being read, interned at the end of the tag
             std::string id, classes;
 
         public:
@@ -289,6 +297,7 @@ namespace XCSP3Core {
         public:
             XVariableArray* varArray;
             XDomainInteger* domain;
+            XDomainInteger parsed; // the domain being read, interned at the end of the tag
             std::string id, classes;
             std::vector<int> sizes;
 
@@ -308,6 +317,7 @@ namespace XCSP3Core {
 
         public:
             XDomainInteger* d;
+            XDomainInteger parsed; // the domain being read, interned at the end of the tag
             std::string forAttr;
 
             DomainTagAction(XMLParser* parser, std::string name) : TagAction(parser, name) {}
@@ -328,7 +338,6 @@ namespace XCSP3Core {
 
             // AttributeList &attributes
             virtual void beginTag(const AttributeList&) {
-                this->checkParentTag("instance");
                 this->parser->manager->beginConstraints();
             }
 
@@ -659,10 +668,15 @@ namespace XCSP3Core {
 
         class ConflictOrSupportTagAction : public TagAction {
         protected:
+            std::vector<UTF8String::Byte> buffer; // the tuples, when parsed with several threads
+
         public:
-            ConflictOrSupportTagAction(XMLParser* parser, std::string name) : TagAction(parser, name) {}
+            ConflictOrSupportTagAction(XMLParser* parser, std::string name) : TagAction(parser, name) {
+                tupleAware = true;
+            }
             void beginTag(const AttributeList& attributes) override;
             void text(const UTF8String txt, bool last) override;
+            void endTag() override;
         };
 
         /***************************************************************************
@@ -687,9 +701,9 @@ namespace XCSP3Core {
 
                 if (match.size() != 3)
                     return;
-                int tmp = std::stoi(match[2].str());
-                if (XParameterVariable::max < tmp)
-                    XParameterVariable::max = tmp;
+                int tmp = toInt(match[2].str());
+                if (this->parser->maxParameter < tmp)
+                    this->parser->maxParameter = tmp;
             }
         };
 
@@ -907,6 +921,15 @@ namespace XCSP3Core {
         };
 
     public:
+        // the document is known to be valid: the structural checks are skipped
+        bool trusted;
+
+        // number of threads parsing large lists of tuples
+        int threads;
+
+        // number of constraints (groups, slides... included) read since the beginning of the document
+        size_t nbConstraints;
+
         XMLParser(XCSP3CoreCallbacksBase* cb);
         ~XMLParser();
 
@@ -915,10 +938,28 @@ namespace XCSP3Core {
          * branch of the XML parse tree
          */
         TagAction* getParentTagAction(int n = 1) {
-            if (n < 0 || n >= static_cast<int>(actionStack.size()))
+            if (n < 0 || n >= depth)
                 return NULL;
 
-            return actionStack[n];
+            return stack[depth - 1 - n].action;
+        }
+
+        /**
+         * the type of the current child of the root (VARIABLES, CONSTRAINTS...),
+         * INSTANCE before the first one and UNKNOWN outside the root
+         */
+        TagType section() const {
+            if (depth == 0)
+                return TagType::UNKNOWN;
+            return stack[depth > 1 ? 1 : 0].action->type;
+        }
+
+        /**
+         * forget the variables of the document parsed before (its objects are destroyed with the pools)
+         */
+        void forgetDocument() {
+            variablesList.clear();
+            domains.clear();
         }
 
         /**
@@ -926,26 +967,57 @@ namespace XCSP3Core {
          */
         void startDocument() {
             clearStacks();
+            internedTagList.clear();
+            nbConstraints = 0;
         }
 
         void endDocument() {}
 
         void startElement(UTF8String name, const AttributeList& attributes);
 
+        /**
+         * start an element whose name is interned (all occurrences of a name have the
+         * same address until the end of the document): the tag action is looked up once per name
+         */
+        void startElement(const UTF8String::Byte* internedName, const AttributeList& attributes);
+
         void endElement(UTF8String name);
 
+        void endElement();
+
         void characters(UTF8String chars);
 
+        /**
+         * the whole text between two tags, given at once: no token
+         * has to be kept for the next call
+         */
+        void wholeText(UTF8String chars);
+
         void handleAbridgedNotation(UTF8String chars, bool lastChunk);
 
     protected:
         void clearStacks() {
-            stateStack.clear();
+            depth = 0;
+            textLeft.clear(); // left by an interrupted parse
         }
 
+        TagAction* getTagAction(UTF8String name);
+
+        void startElement(TagAction* action, const AttributeList& attributes);
+
         // text which is left for the next call to characters() because it
-        // may not be a complete token
-        UTF8String textLeft;
+        // may not be a complete token (raw bytes of the end of the last chunk)
+        std::vector<UTF8String::Byte> textLeft;
+
+        /**
+         * give the text left to the current tag action, as the last chunk of text
+         */
+        void flushTextLeft() {
+            if (!textLeft.empty()) {
+                handleAbridgedNotation(UTF8String(textLeft.data(), textLeft.data() + textLeft.size()), true);
+                textLeft.clear();
+            }
+        }
 
         // specific actions
         VarTagAction* varTagAction;
@@ -0,0 +1,76 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XMLTAGS_H
+#define XMLTAGS_H
+
+#include <cstddef>
+
+namespace XCSP3Core {
+
+    /**
+     * The tags known by the parser
+     */
+    enum class TagType : unsigned char {
+        UNKNOWN,
+        INSTANCE, VARIABLES, VAR, ARRAY, DOMAIN, ANNOTATIONS, DECISION, CONSTRAINTS,
+        EXTENSION, LIST, SUPPORTS, CONFLICTS, INTENSION, ALLDIFFERENT, ALLEQUAL, SUM,
+        COEFFS, CONDITION, ORDERED, CHANNEL, LEX, COUNT, CARDINALITY, VALUES,
+        VALUE, NVALUES, INSTANTIATION, GROUP, ARGS, MINIMUM, MAXIMUM, INDEX,
+        ELEMENT, NOOVERLAP, CUMULATIVE, ORIGINS, LENGTHS, ENDS, HEIGHTS, OCCURS,
+        STRETCH, WIDTHS, OPERATOR, REGULAR, MDD, START, FINAL, TRANSITIONS,
+        PATTERNS, CLAUSE, OBJECTIVES, MINIMIZE, MAXIMIZE, EXCEPT, MATRIX, BLOCK,
+        SLIDE, CIRCUIT, SIZE,
+        NB // number of tag types
+    };
+
+    /**
+     * The attributes read by the parser
+     */
+    enum class AttributeType : unsigned char {
+        ID, CLASS, TYPE, AS, SIZE, FOR, CASE, ZEROIGNORED,
+        CLOSED, STARTINDEX, OFFSET, CIRCULAR, RANK, STARTROWINDEX, STARTCOLINDEX,
+        NB // number of attribute types, also used for unknown attributes
+    };
+
+    /**
+     * the type of the tag with the given name (UNKNOWN if it is not a XCSP3 tag)
+     */
+    TagType tagType(const unsigned char* name, size_t length);
+
+    /**
+     * the type of the attribute with the given name (AttributeType::NB if it is unknown)
+     */
+    AttributeType attributeType(const unsigned char* name, size_t length);
+
+    const char* tagName(TagType type);
+
+    /**
+     * the tag which must be the parent of the given one (UNKNOWN if the parent is not constrained)
+     */
+    TagType parentTagType(TagType type);
+
+} // namespace XCSP3Core
+
+#endif /* XMLTAGS_H */
@@ -0,0 +1,85 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#ifndef XMLTOKENIZER_H
+#define XMLTOKENIZER_H
+
+#include "XMLParser.h"
+#include <cstddef>
+#include <vector>
+
+namespace XCSP3Core {
+
+    /**
+     * A tokenizer dedicated to the small subset of XML used by XCSP3 instances
+     * (elements, attributes, text, comments and processing instructions).
+     * It scans a document entirely available in memory and drives the
+     * XMLParser callbacks directly, without going through libxml2.
+     * Documents using other XML features (DTD, entities, CDATA sections,
+     * encodings other than UTF-8) must be given to libxml2 instead.
+     */
+    class XMLTokenizer {
+    public:
+        typedef unsigned char Byte;
+
+        explicit XMLTokenizer(XMLParser* p) : parser(p), begin(nullptr), cur(nullptr), end(nullptr) {}
+
+        /**
+         * Return true if the document only uses the XML features handled by this tokenizer
+         */
+        static bool handles(const char* data, size_t size);
+
+        /**
+         * Parse the document. Throw an exception if it is not well-formed.
+         */
+        void parse(const char* data, size_t size);
+
+        /**
+         * The line of the current position in the document
+         */
+        int line() const;
+
+    private:
+        struct Attribute {
+            const char *name, *nameEnd, *value, *valueEnd;
+        };
+
+        XMLParser* parser;
+        const char *begin, *cur, *end;
+        std::vector<UTF8String> openTags;
+        std::vector<Attribute> attributes;
+        std::vector<Byte> scratch;         // NUL terminated copies of the attribute names and values
+        std::vector<const Byte*> attrList; // the attribute list given to AttributeList
+
+        void text(const char* b, const char* e);
+        void startTag();
+        void endTag();
+        void skipPast(const char* terminator, size_t length);
+        void skipSpaces(const char*& p);
+        [[noreturn]] void error(const char* message);
+    };
+
+} // namespace XCSP3Core
+
+#endif /* XMLTOKENIZER_H */
@@ -0,0 +1,53 @@
+#include "XCSP3utils.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace XCSP3Core;
+
+// Decode n integers of the given width (in digits, 0 for mixed widths) with several decoders and
+// print the time spent per integer
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+
+    std::mt19937 rng(42);
+    long long checksum = 0; // printed so that the decoding loops are not optimized out
+    std::cout << "digits,parseInt (ns/int),strtol (ns/int),stoi (ns/int)\n";
+    for (int digits = 0; digits <= 10; digits += (digits == 0 ? 1 : 3)) {
+        std::vector<std::string> values;
+        for (size_t i = 0; i < 1024; i++) {
+            int d = digits == 0 ? 1 + static_cast<int>(rng() % 9) : digits;
+            std::string s = (rng() % 4 == 0) ? "-" : "";
+            s += static_cast<char>('1' + rng() % 9);
+            for (int j = 1; j < d; j++)
+                s += static_cast<char>('0' + rng() % 10);
+            if (d == 10)
+                s[s[0] == '-' ? 1 : 0] = '1';
+            values.push_back(s);
+        }
+
+        std::cout << (digits == 0 ? "mixed" : std::to_string(digits));
+        for (int method = 0; method < 3; method++) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < n; i++) {
+                const std::string& s = values[i & 1023];
+                int v = 0;
+                if (method == 0)
+                    parseInt(s.data(), s.data() + s.size(), v);
+                else if (method == 1)
+                    v = static_cast<int>(std::strtol(s.c_str(), nullptr, 10));
+                else
+                    v = std::stoi(s);
+                checksum += v;
+            }
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << "," << elapsed.count() / static_cast<double>(n);
+        }
+        std::cout << "\n";
+    }
+    std::cerr << "checksum " << checksum << std::endl;
+    return 0;
+}
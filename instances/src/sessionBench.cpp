@@ -0,0 +1,61 @@
+#include "XCSP3ParserSession.h"
+#include "XCSP3SummaryCallbacks.h"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace XCSP3Core;
+
+namespace {
+    // the summary of each run is not printed
+    class QuietSummaryCallbacks : public XCSP3SummaryCallbacks {
+    public:
+        void endInstance() override {}
+    };
+
+    // return the time in seconds of runs parses of the document, each one with a new parser
+    double withParsers(const std::vector<char>& document, int runs) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < runs; i++) {
+            QuietSummaryCallbacks cb;
+            XCSP3CoreParser parser(&cb);
+            parser.parse(document.data(), document.size());
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+
+    // return the time in seconds of runs parses of the document with the same session
+    double withSession(const std::vector<char>& document, int runs) {
+        QuietSummaryCallbacks first;
+        XCSP3ParserSession session(&first);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < runs; i++) {
+            QuietSummaryCallbacks cb;
+            session.setCallbacks(&cb);
+            session.parse(document.data(), document.size());
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+} // namespace
+
+// Compare the time to parse many times a (small) instance with a new parser each time and with a session
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3)
+        throw std::runtime_error("usage: ./benchmarkSession instance.xml [runs]");
+    int runs = argc == 3 ? std::stoi(argv[2]) : 10000;
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+        throw std::runtime_error("unable to open " + std::string(argv[1]));
+    std::vector<char> document((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    double parsers = withParsers(document, runs);
+    double session = withSession(document, runs);
+    std::cout << "parsers (us/parse),session (us/parse),speedup\n";
+    std::cout << parsers * 1e6 / runs << "," << session * 1e6 / runs << "," << parsers / session << "\n";
+    return 0;
+}
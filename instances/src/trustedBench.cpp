@@ -0,0 +1,56 @@
+#include "XCSP3CoreParser.h"
+#include "XCSP3SummaryCallbacks.h"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace XCSP3Core;
+
+namespace {
+    // the summary of each run is not printed
+    class QuietSummaryCallbacks : public XCSP3SummaryCallbacks {
+    public:
+        void endInstance() override {}
+    };
+
+    // return the best time in seconds of runs parses of the document
+    double bestTime(const std::vector<char>& document, bool nativeTokenizer, bool trusted, int runs) {
+        double best = 0;
+        for (int i = 0; i < runs; i++) {
+            QuietSummaryCallbacks cb;
+            XCSP3CoreParser parser(&cb);
+            parser.nativeTokenizer = nativeTokenizer;
+            parser.trusted = trusted;
+            auto start = std::chrono::steady_clock::now();
+            parser.parse(document.data(), document.size());
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (i == 0 || elapsed.count() < best)
+                best = elapsed.count();
+        }
+        return best;
+    }
+} // namespace
+
+// Compare the throughput of the parser with and without the trusted option
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3)
+        throw std::runtime_error("usage: ./benchmarkTrusted instance.xml [runs]");
+    int runs = argc == 3 ? std::stoi(argv[2]) : 5;
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+        throw std::runtime_error("unable to open " + std::string(argv[1]));
+    std::vector<char> document((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    double megabytes = static_cast<double>(document.size()) / (1 << 20);
+
+    std::cout << "tokenizer,checked (MB/s),trusted (MB/s),speedup\n";
+    for (int native = 0; native < 2; native++) {
+        double checked = bestTime(document, native, false, runs);
+        double trusted = bestTime(document, native, true, runs);
+        std::cout << (native ? "native" : "libxml2") << "," << megabytes / checked << "," << megabytes / trusted << ","
+                  << checked / trusted << "\n";
+    }
+    return 0;
+}
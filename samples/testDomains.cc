@@ -0,0 +1,77 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+
+#include "XCSP3CoreParser.h"
+#include "XCSP3PrintCallbacks.h"
+#include <cstring>
+#include <map>
+
+using namespace XCSP3Core;
+
+// Records which of the two buildVariableInteger is called for each variable
+class DomainCallbacks : public XCSP3PrintCallbacks {
+public:
+    std::map<std::string, std::string> built;
+
+    void buildVariableInteger(const std::string& id, int minValue, int maxValue) override {
+        built[id] = "range " + std::to_string(minValue) + ".." + std::to_string(maxValue);
+    }
+
+    void buildVariableInteger(const std::string& id, const std::vector<int>& values) override {
+        built[id] = "list of " + std::to_string(values.size());
+    }
+};
+
+// Equal domains are stored once, as written where they first appear: the callback of a variable
+// must not depend on the domains declared before it.
+static const char* document =
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables>"
+        "<var id=\"x\"> 1 2 3 </var><var id=\"y\"> 1..3 </var>"
+        "<var id=\"z\"> 1 3 </var><var id=\"w\"> 1 3 </var>"
+        "<array id=\"t\" size=\"[2]\"> 4 5 6 </array><array id=\"u\" size=\"[2]\"> 4..6 </array>"
+        "</variables><constraints><allDifferent> t[] u[] </allDifferent></constraints></instance>";
+
+static const char* expected[][2] = {{"x", "range 1..3"},    {"y", "range 1..3"},    {"z", "list of 2"}, {"w", "list of 2"},
+                                    {"t[0]", "range 4..6"}, {"u[1]", "range 4..6"}};
+
+int main() {
+    int failures = 0;
+    for (int native = 0; native < 2; native++) {
+        DomainCallbacks cb;
+        XCSP3CoreParser parser(&cb);
+        parser.nativeTokenizer = native;
+        std::streambuf* out = std::cout.rdbuf(nullptr); // the other callbacks print nothing
+        parser.parse(document, strlen(document));
+        std::cout.rdbuf(out);
+        for (auto& e : expected) {
+            if (cb.built[e[0]] != e[1]) {
+                std::cout << e[0] << ": " << cb.built[e[0]] << " instead of " << e[1] << std::endl;
+                failures++;
+            }
+        }
+    }
+    std::cout << failures << " failure(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
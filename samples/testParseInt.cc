@@ -0,0 +1,82 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+
+#include "XCSP3utils.h"
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+using namespace XCSP3Core;
+
+// The reference: strtoll, with the syntax of parseInt (an optional sign followed by digits, nothing else)
+static bool reference(const std::string& s, int& v) {
+    size_t i = s.size() > 0 && (s[0] == '+' || s[0] == '-') ? 1 : 0;
+    if (i == s.size())
+        return false;
+    for (size_t j = i; j < s.size(); j++)
+        if (s[j] < '0' || s[j] > '9')
+            return false;
+    errno = 0;
+    long long r = strtoll(s.c_str(), nullptr, 10);
+    if (errno != 0 || r > INT_MAX || r < INT_MIN)
+        return false;
+    v = static_cast<int>(r);
+    return true;
+}
+
+static int failures = 0;
+
+static void check(const std::string& s) {
+    int v = 7, w = 7; // left unchanged when rejected
+    bool parsed = parseInt(s.data(), s.data() + s.size(), v), expected = reference(s, w);
+    if (parsed != expected || v != w) {
+        if (failures++ < 10)
+            std::cout << "'" << s << "': parseInt " << parsed << " " << v << ", strtoll " << expected << " " << w << std::endl;
+    }
+}
+
+int main() {
+    // The limits, and the lengths around the 8 digits converted at once
+    const char* edges[] = {"2147483647", "2147483648", "-2147483648", "-2147483649", "00000000002147483647", "99999999999",
+                           "4294967296", "12345678",   "-12345678",   "1234567/",    "123456789",            "+0",
+                           "-",          "",           "+-1",         "00000000",    "0000000a"};
+    for (const char* s : edges)
+        check(s);
+
+    // Random strings, mostly of digits
+    std::mt19937 random(1);
+    const char alphabet[] = "0123456789+-/:a 0009";
+    for (int i = 0; i < 2000000; i++) {
+        std::string s;
+        for (int n = random() % 22; n > 0; n--)
+            s += alphabet[random() % (random() % 4 != 0 ? 10 : 20)];
+        check(s);
+    }
+    std::cout << failures << " failure(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,70 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+
+#include "XCSP3CoreParser.h"
+#include "XCSP3PrintCallbacks.h"
+#include <cstring>
+#include <memory>
+
+using namespace XCSP3Core;
+
+// Truncated documents, each of which must be rejected by the native tokenizer.
+// Each one is copied into a buffer of its exact size: run it under valgrind or
+// with -fsanitize=address to catch a read past the end.
+static const char* truncated[] = {
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables><var id=\"x\"> 0..3 </var></variables>\n<",
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables><var id=\"x\"> 0..3 <",
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables><var id=\"x\"> 0..3 </var",
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables><var id=\"x",
+        "<instance format=\"XCSP3\" type=\"CSP\"><variables><var id=\"x\"> 0..3 </var></variables></",
+        "<",
+};
+
+int main() {
+    int failures = 0;
+    for (const char* document : truncated) {
+        size_t size = strlen(document);
+        std::unique_ptr<char[]> buffer(new char[size]);
+        memcpy(buffer.get(), document, size);
+
+        XCSP3PrintCallbacks cb;
+        XCSP3CoreParser parser(&cb);
+        parser.nativeTokenizer = true;
+        std::streambuf* out = std::cout.rdbuf(nullptr); // the callbacks print nothing
+        bool rejected = false;
+        try {
+            parser.parse(buffer.get(), size);
+        } catch (std::exception& e) {
+            rejected = true;
+        }
+        std::cout.rdbuf(out);
+        if (!rejected) {
+            std::cout << "not rejected: " << document << std::endl;
+            failures++;
+        }
+    }
+    std::cout << failures << " failure(s)" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
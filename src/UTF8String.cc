@@ -25,6 +25,14 @@
  */
 
 #include "UTF8String.h"
+#include "XCSP3utils.h"
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 using namespace XCSP3Core;
 
@@ -230,36 +238,15 @@ bool UTF8String::to(std::string& v) const {
 }
 
 bool UTF8String::to(int& v) const {
-    iterator it(_beg), end(_end);
-    bool neg = false;
-
-    while (it != end && it.isWhiteSpace())
-        ++it;
-
-    if (it == end || it.firstByte() == 0) // end of string?
-        return false;
+    const Byte* b = _beg;
+    const Byte* e = end().getPointer();
 
-    if (*it == '+')
-        ++it;
-    else if (*it == '-') {
-        ++it;
-        neg = true;
-    }
-
-    v = 0;
-    while (it != end && *it >= '0' && *it <= '9') {
-        //??? #warning "must check for overflows"
-        v = v * 10 + (*it - '0');
-        ++it;
-    }
+    while (b != e && *b < 128 && isspace(*b))
+        ++b;
+    while (e != b && e[-1] < 128 && isspace(e[-1]))
+        --e;
 
-    if (neg)
-        v = -v;
-
-    while (it != end && it.isWhiteSpace())
-        ++it;
-
-    return it == end || it.firstByte() == 0;
+    return parseInt(reinterpret_cast<const char*>(b), reinterpret_cast<const char*>(e), v);
 }
 
 void UTF8String::appendTo(std::string& v) const {
@@ -321,7 +308,7 @@ UTF8String::iterator::iterator(const Byte* s) {
     p = s;
 }
 
-int UTF8String::iterator::operator*() {
+int UTF8String::iterator::decode() {
     int ch = *p;
 
     switch (codeLength(ch)) {
@@ -332,16 +319,20 @@ int UTF8String::iterator::operator*() {
         addNextByte(ch);
         return ch;
     case 3:
+#ifndef XCSP3_TRUSTED_UTF8
         if ((ch == 0xE0 && p[1] < 0xA0) || (ch == 0xED && p[1] > 0x9F))
             throw std::runtime_error("invalid UTF8 character");
+#endif
 
         ch &= 0x0F;
         addNextByte(ch);
         addNextByte(ch);
         return ch;
     case 4:
+#ifndef XCSP3_TRUSTED_UTF8
         if ((ch == 0xF0 && p[1] < 0x90) || (ch == 0xF4 && p[1] > 0x8F))
             throw std::runtime_error("invalid UTF8 character");
+#endif
 
         ch &= 0x07;
         addNextByte(ch);
@@ -353,12 +344,6 @@ int UTF8String::iterator::operator*() {
     }
 }
 
-UTF8String::iterator& UTF8String::iterator::operator++() // prefix
-{
-    p += codeLength(*p);
-    return *this;
-}
-
 UTF8String::iterator UTF8String::iterator::operator++(int) // postfix
 {
     iterator tmp = *this;
@@ -408,8 +393,49 @@ Byte UTF8String::iterator::firstByte() const {
     return *p;
 }
 
-//------------------------ ITERATOR INTERN CLASS ------------------------
-UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s._beg), end(s._end) {
+//------------------------ ASCII FAST PATH ------------------------
+
+bool UTF8String::isAscii(const Byte* p, const Byte* e) {
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for (; e - p >= 32; p += 32)
+        acc = _mm256_or_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+    if (_mm256_movemask_epi8(acc) != 0)
+        return false;
+#elif defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for (; e - p >= 16; p += 16)
+        acc = _mm_or_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+    if (_mm_movemask_epi8(acc) != 0)
+        return false;
+#endif
+    for (; p != e; ++p)
+        if (*p >= 0x80)
+            return false;
+    return true;
+}
+
+//------------------------ TOKENIZER INTERN CLASS ------------------------
+
+namespace {
+    // class of each byte before any separator is added
+    struct BaseByteClass {
+        unsigned char table[256];
+
+        BaseByteClass() {
+            memset(table, 0, sizeof(table));
+            table[0] = 3; // NUL
+            for (int ch : {' ', '\n', '\r', '\t', '\v', '\f'})
+                table[ch] = 1; // SPACE
+        }
+    };
+
+    const BaseByteClass baseByteClass;
+} // namespace
+
+UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s.begin()), end(s.end()), nbAsciiSeparators(0) {
+    ascii = isAscii(it.getPointer(), end.getPointer());
+    memcpy(byteClass, baseByteClass.table, sizeof(byteClass));
     skipWhiteSpace();
 }
 
@@ -417,7 +443,45 @@ UTF8String::Tokenizer::Tokenizer(const UTF8String s) : it(s._beg), end(s._end) {
  * Character ch will be returned as one token
  */
 void UTF8String::Tokenizer::addSeparator(int ch) {
-    separators.push_back(ch);
+    if (ch >= 128) {
+        separators.push_back(ch);
+        return;
+    }
+    byteClass[ch] = SEPARATOR;
+    if (nbAsciiSeparators >= 0 && nbAsciiSeparators < 8)
+        asciiSeparators[nbAsciiSeparators++] = static_cast<char>(ch);
+    else
+        nbAsciiSeparators = -1;
+}
+
+const UTF8String::Byte* UTF8String::Tokenizer::tokenEnd(const Byte* p, const Byte* e) const {
+    // most tokens are short (integers): look at the first bytes one by one
+    const Byte* stop = e - p > 16 ? p + 16 : e;
+    while (p != stop && byteClass[*p] == TOKEN)
+        ++p;
+    if (p != stop || p == e)
+        return p;
+
+#ifdef __SSE2__
+    // long tokens: look for a white space, a NUL or a separator 16 bytes at a time
+    if (nbAsciiSeparators >= 0) {
+        const __m128i nine = _mm_set1_epi8(9), four = _mm_set1_epi8(4), space = _mm_set1_epi8(' '), zero = _mm_setzero_si128();
+        for (; e - p >= 16; p += 16) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            __m128i shifted = _mm_sub_epi8(bytes, nine); // \t \n \v \f \r are 9..13
+            __m128i stops = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(shifted, four), shifted), _mm_cmpeq_epi8(bytes, space));
+            stops = _mm_or_si128(stops, _mm_cmpeq_epi8(bytes, zero));
+            for (int i = 0; i < nbAsciiSeparators; i++)
+                stops = _mm_or_si128(stops, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(asciiSeparators[i])));
+            int mask = _mm_movemask_epi8(stops);
+            if (mask != 0)
+                return p + __builtin_ctz(mask);
+        }
+    }
+#endif
+    while (p != e && byteClass[*p] == TOKEN)
+        ++p;
+    return p;
 }
 
 bool UTF8String::Tokenizer::hasMoreTokens() {
@@ -430,13 +494,18 @@ UTF8String UTF8String::Tokenizer::nextToken() {
     if (it == end || it.firstByte() == 0)
         return UTF8String();
 
-    if (isSeparator(*it))
-        ++it;
-    else
-        while (it != end && *it && !it.isWhiteSpace() && !isSeparator(*it))
+    if (ascii) {
+        e = byteClass[*b] == SEPARATOR ? b + 1 : tokenEnd(b, end.getPointer());
+        it = iterator(e);
+    } else {
+        if (isSeparator(*it))
             ++it;
+        else
+            while (it != end && *it && !it.isWhiteSpace() && !isSeparator(*it))
+                ++it;
 
-    e = it.getPointer();
+        e = it.getPointer();
+    }
 
     skipWhiteSpace();
 
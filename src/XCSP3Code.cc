@@ -30,21 +30,14 @@
 #include "XCSP3Objective.h"
 #include "XCSP3Tree.h"
 #include "XCSP3Variable.h"
+#include <algorithm>
 #include <assert.h>
+#include <cstdio>
+#include <cstring>
 
 using namespace XCSP3Core;
 
 namespace XCSP3Core {
-    // Special global vars...
-    std::vector<XTransition> tr; // Not beautiful but remove code to fixed data in group constraint.
-    std::string st;
-    std::vector<std::string> fi;
-    std::vector<int> _except;
-    OrderType _op;
-    std::vector<int> _values;
-
-    int XParameterVariable::max;
-
     //------------------------------------------------------------------------------------------
     //  XCSP3Domain.h functions
     //------------------------------------------------------------------------------------------
@@ -54,33 +47,225 @@ namespace XCSP3Core {
     }
 
     std::ostream& operator<<(std::ostream& f, const XDomainInteger& d) {
-        for (XIntegerEntity* xi : d.values)
-            f << *xi;
+        for (XDomainInteger::Interval xi : d.values) {
+            if (xi.min == xi.max)
+                f << xi.min << " ";
+            else
+                f << xi.min << ".." << xi.max << " ";
+        }
         return f;
     }
+
+    // A domain goes to a bitset when it has at least MIN_BITSET intervals, and its span is smaller than
+    // DENSE times their number. It goes back to intervals when its span becomes larger than SPARSE times this number.
+    static const size_t MIN_BITSET = 64;
+    static const int64_t DENSE = 32;
+    static const int64_t SPARSE = 128;
+
+    const uint32_t XDomainInteger::NO_ID;
+
+    void XDomainInteger::Values::iterator::find() {
+        if (domain->bits.empty()) {
+            if (position < domain->intervals.size())
+                current = domain->intervals[position];
+            return;
+        }
+        const std::vector<uint64_t>& bits = domain->bits;
+        size_t end = bits.size() * 64;
+        while (position < end && (bits[position / 64] & (uint64_t(1) << (position % 64))) == 0)
+            position++;
+        if (position == end)
+            return;
+        size_t last = position;
+        while (last + 1 < end && (bits[(last + 1) / 64] & (uint64_t(1) << ((last + 1) % 64))) != 0)
+            last++;
+        current.min = domain->base + static_cast<int>(position);
+        current.max = domain->base + static_cast<int>(last);
+    }
+
+    XDomainInteger::Interval XDomainInteger::Values::operator[](size_t i) const {
+        if (domain.bits.empty())
+            return domain.intervals[i];
+        iterator it = begin();
+        while (i-- > 0)
+            ++it;
+        return *it;
+    }
+
+    bool XDomainInteger::contains(int v) const {
+        if (size == 0 || v < minimum() || v > top)
+            return false;
+        if (!bits.empty()) {
+            size_t i = static_cast<size_t>(static_cast<int64_t>(v) - base);
+            return (bits[i / 64] & (uint64_t(1) << (i % 64))) != 0;
+        }
+        std::vector<Interval>::const_iterator next = std::upper_bound(intervals.begin(), intervals.end(), v,
+                                                                     [](int value, const Interval& xi) { return value < xi.min; });
+        return v <= (next - 1)->max;
+    }
+
+    const std::vector<int>& XDomainInteger::allValues() const {
+        if (expanded.size() != static_cast<size_t>(size)) {
+            expanded.clear();
+            expanded.reserve(size);
+            for (Interval xi : values)
+                for (int64_t v = xi.min; v <= xi.max; v++)
+                    expanded.push_back(static_cast<int>(v));
+        }
+        return expanded;
+    }
+
+    void XDomainInteger::setBits(int min, int max) {
+        size_t last = static_cast<size_t>(static_cast<int64_t>(max) - base);
+        if (bits.size() <= last / 64)
+            bits.resize(last / 64 + 1, 0);
+        for (size_t i = static_cast<size_t>(static_cast<int64_t>(min) - base); i <= last; i++)
+            bits[i / 64] |= uint64_t(1) << (i % 64);
+    }
+
+    void XDomainInteger::toBitset() {
+        base = intervals[0].min;
+        nbRuns = 0;
+        int previous = base;
+        for (const Interval& xi : intervals) {
+            if (nbRuns == 0 || xi.min != previous + 1)
+                nbRuns++;
+            setBits(xi.min, xi.max);
+            previous = xi.max;
+        }
+        std::vector<Interval>().swap(intervals);
+    }
+
+    void XDomainInteger::toIntervals() {
+        std::vector<Interval> runs;
+        runs.reserve(nbRuns);
+        for (Interval xi : values)
+            runs.push_back(xi);
+        std::vector<uint64_t>().swap(bits);
+        intervals.swap(runs);
+    }
+
+    void XDomainInteger::add(int min, int max) {
+        if (!bits.empty() && static_cast<int64_t>(max) - base + 1 > SPARSE * static_cast<int64_t>(nbRuns + 1))
+            toIntervals();
+        if (bits.empty()) {
+            intervals.push_back(Interval{min, max});
+            if (intervals.size() >= MIN_BITSET
+                && static_cast<int64_t>(max) - intervals[0].min + 1 < DENSE * static_cast<int64_t>(intervals.size()))
+                toBitset();
+        } else {
+            if (min != top + 1)
+                nbRuns++;
+            setBits(min, max);
+        }
+        size += max - min + 1;
+        top = max;
+    }
+
+    bool XDomainInteger::equals(const XDomainInteger* arg) const {
+        if (this == arg)
+            return true;
+        if (nbValues() != arg->nbValues() || (size > 0 && (minimum() != arg->minimum() || maximum() != arg->maximum())))
+            return false;
+        // compare the maximal intervals of the two domains
+        Values::iterator it1 = values.begin(), end1 = values.end(), it2 = arg->values.begin(), end2 = arg->values.end();
+        while (it1 != end1 && it2 != end2) {
+            Interval xi1 = *it1, xi2 = *it2;
+            for (++it1; it1 != end1 && it1->min == xi1.max + 1; ++it1)
+                xi1.max = it1->max;
+            for (++it2; it2 != end2 && it2->min == xi2.max + 1; ++it2)
+                xi2.max = it2->max;
+            if (xi1.min != xi2.min || xi1.max != xi2.max)
+                return false;
+        }
+        return it1 == end1 && it2 == end2;
+    }
+
+    uint32_t XDomainInteger::hash() const {
+        // the hash of the maximal intervals, as compared by equals
+        uint32_t h = 2166136261u;
+        for (Values::iterator it = values.begin(), end = values.end(); it != end;) {
+            Interval xi = *it;
+            for (++it; it != end && it->min == xi.max + 1; ++it)
+                xi.max = it->max;
+            h = (h ^ static_cast<uint32_t>(xi.min)) * 16777619u;
+            h = (h ^ static_cast<uint32_t>(xi.max)) * 16777619u;
+        }
+        return h;
+    }
+
+    void XDomainInteger::assign(const XDomainInteger& other) {
+        size = other.size;
+        top = other.top;
+        intervals.assign(other.intervals.begin(), other.intervals.end());
+        base = other.base;
+        bits.assign(other.bits.begin(), other.bits.end());
+        nbRuns = other.nbRuns;
+    }
+
+    void XDomainInteger::clear() {
+        size = 0;
+        top = std::numeric_limits<int>::min();
+        intervals.clear();
+        base = 0;
+        bits.clear();
+        nbRuns = 0;
+        id = NO_ID;
+        expanded.clear();
+    }
+
+    XDomainInteger* XDomainTable::intern(const XDomainInteger& domain) {
+        if (4 * (count + 1) > 3 * slots.size())
+            rehash();
+        size_t mask = slots.size() - 1;
+        size_t i = domain.hash() & mask;
+        for (; slots[i] != nullptr; i = (i + 1) & mask)
+            if (slots[i]->equals(&domain))
+                return slots[i];
+
+        XDomainInteger* made = DataPool::current().DomainPool.make<XDomainInteger>();
+        made->assign(domain);
+        made->id = static_cast<uint32_t>(count++);
+        slots[i] = made;
+        return made;
+    }
+
+    void XDomainTable::rehash() {
+        std::vector<XDomainInteger*> old(std::max(static_cast<size_t>(64), 2 * slots.size()), nullptr);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (XDomainInteger* domain : old) {
+            if (domain == nullptr)
+                continue;
+            size_t i = domain->hash() & mask;
+            while (slots[i] != nullptr)
+                i = (i + 1) & mask;
+            slots[i] = domain;
+        }
+    }
+
+    void XDomainTable::clear() {
+        std::fill(slots.begin(), slots.end(), nullptr);
+        count = 0;
+    }
 } // namespace XCSP3Core
 
 //------------------------------------------------------------------------------------------
 //  XCSP3Variable.h functions
 //------------------------------------------------------------------------------------------
 
-XEntity::XEntity() : id("") {}
+XEntity::XEntity() {}
 
 XEntity::~XEntity() {}
 
-XEntity::XEntity(std::string lid) { id = lid; }
-
-XVariable::XVariable(std::string idd, XDomainInteger* dom) : XEntity(idd), domain(dom) {}
+XEntity::XEntity(std::string lid) : id(lid) {}
 
-XVariable::XVariable(std::string idd, XDomainInteger* dom, std::vector<int> indexes) {
-    domain = dom;
-    std::stringstream oss;
-    oss << idd;
+const uint32_t XVariable::NO_HANDLE;
 
-    for (unsigned int i = 0; i < indexes.size(); i++)
-        oss << "[" << indexes[i] << "]";
+XVariable::XVariable(std::string idd, XDomainInteger* dom) : XEntity(idd), domain(dom), handle(NO_HANDLE) {}
 
-    id = oss.str();
+XVariable::XVariable(Symbol idd, XDomainInteger* dom, uint32_t h) : domain(dom), handle(h) {
+    id = idd;
 }
 
 XVariable::~XVariable() {}
@@ -89,9 +274,7 @@ XParameterVariable::XParameterVariable(std::string lid) : XVariable(lid, NULL) {
     if (id[1] == '.')
         number = -1;
     else
-        number = std::stoi(id.substr(1));
-    if (max < number)
-        max = number;
+        number = toInt(id.substr(1));
 }
 
 namespace XCSP3Core {
@@ -138,30 +321,25 @@ bool XCSP3Core::isVariable(XEntity* xe, XVariable*& v) {
     return false;
 }
 
-XVariableArray::XVariableArray(std::string id, std::vector<int> szs) : XEntity(id), sizes(szs.begin(), szs.end()) {
-    int nb = 1;
+const size_t XVariableArray::PAGE_SIZE;
+
+XVariableArray::XVariableArray(std::string id, std::vector<int> szs)
+    : XEntity(id), owner(&DataPool::current()), nbCells(1), domains(std::make_shared<Domains>()), sizes(szs.begin(), szs.end()) {
     for (int sz : sizes)
-        nb *= sz;
-    variables.assign(nb, NULL);
+        nbCells *= sz;
 }
 
-XVariableArray::XVariableArray(std::string idd, XVariableArray* as) : sizes(as->sizes.begin(), as->sizes.end()) {
-    std::vector<int> indexes;
-    indexes.assign(as->sizes.size(), 0);
-    variables.assign(as->variables.size(), NULL);
-    id = idd;
-    for (unsigned int i = 0; i < variables.size(); i++) {
-        variables[i] = DataPool::EntityPool.make<XVariable>(idd, as->variables[i]->domain, indexes);
-        for (int j = sizes.size() - 1; j >= 0; j--)
-            if (++indexes[j] == sizes[j])
-                indexes[j] = 0;
-            else
-                break;
-    }
-}
+XVariableArray::XVariableArray(std::string idd, XVariableArray* as)
+    : XEntity(idd), owner(as->owner), nbCells(as->nbCells), domains(as->domains), sizes(as->sizes.begin(), as->sizes.end()) {}
 
 XVariableArray::~XVariableArray() {}
 
+XVariableArray::Domains& XVariableArray::ownDomains() {
+    if (domains.use_count() > 1)
+        domains = std::make_shared<Domains>(*domains);
+    return *domains;
+}
+
 void XVariableArray::indexesFor(int flatIndex, std::vector<int>& indexes) {
     indexes.resize(sizes.size());
     for (int i = indexes.size() - 1; i > 0; i--) {
@@ -171,71 +349,175 @@ void XVariableArray::indexesFor(int flatIndex, std::vector<int>& indexes) {
     indexes[0] = flatIndex;
 }
 
-bool XVariableArray::incrementIndexes(std::vector<int>& indexes, std::vector<XIntegerEntity*>& ranges) {
+bool XVariableArray::incrementIndexes(std::vector<int>& indexes, const std::vector<int>& first, const std::vector<int>& last) {
     int j = indexes.size() - 1;
     for (; j >= 0; j--)
-        if (ranges[j]->width() == 1)
+        if (first[j] == last[j])
             continue;
-        else if (++indexes[j] > ranges[j]->maximum())
-            indexes[j] = ranges[j]->minimum();
+        else if (++indexes[j] > last[j])
+            indexes[j] = first[j];
         else
             break;
     return j >= 0;
 }
 
-void XVariableArray::getVarsFor(std::vector<XVariable*>& list, std::string compactForm, std::vector<int>* flatIndexes, bool storeIndexes) {
-    std::vector<XIntegerEntity*> ranges;
-    std::string tmp;
+void XVariableArray::rangesFor(const std::string& compactForm, std::vector<int>& first, std::vector<int>& last) const {
+    first.clear();
+    last.clear();
+    size_t begin = 0;
     // Compute the different ranges for all dimension
     for (unsigned int i = 0; i < sizes.size(); i++) {
-        int pos = compactForm.find(']');
-        tmp = compactForm.substr(1, pos - 1);
-        compactForm = compactForm.substr(pos + 1);
+        size_t end = compactForm.find(']', begin);
+        if (compactForm.compare(begin, 1, "[") != 0 || end == std::string::npos)
+            throw std::runtime_error("Bad compact form for array " + id + ": " + compactForm);
+        std::string tmp = compactForm.substr(begin + 1, end - begin - 1);
+        begin = end + 1;
         if (tmp.size() == 0) {
-            ranges.push_back(DataPool::IntegerEntityPool.make<XIntegerInterval>(0, sizes[i] - 1));
+            first.push_back(0);
+            last.push_back(sizes[i] - 1);
         } else {
             size_t dot = tmp.find("..");
-            if (dot == std::string::npos)
-                ranges.push_back(DataPool::IntegerEntityPool.make<XIntegerValue>(std::stoi(tmp)));
-            else {
-                int first = std::stoi(tmp.substr(0, dot));
-                int last = std::stoi(tmp.substr(dot + 2));
-                ranges.push_back(DataPool::IntegerEntityPool.make<XIntegerInterval>(first, last));
+            if (dot == std::string::npos) {
+                first.push_back(toInt(tmp));
+                last.push_back(first.back());
+            } else {
+                first.push_back(toInt(tmp.substr(0, dot)));
+                last.push_back(toInt(tmp.substr(dot + 2)));
             }
+            if (first.back() < 0 || first.back() > last.back() || last.back() >= sizes[i])
+                throw std::runtime_error("Bad range in compact form for array " + id + ": " + compactForm);
         }
     }
-    // Compute the first one
-    std::vector<int> indexes;
-    for (unsigned int i = 0; i < sizes.size(); i++)
-        indexes.push_back(ranges[i]->minimum());
+}
+
+void XVariableArray::getVarsFor(std::vector<XVariable*>& list, const std::string& compactForm) {
+    std::vector<int> first, last;
+    rangesFor(compactForm, first, last);
 
     // Compute all necessary variables
+    std::vector<int> indexes(first);
     do {
-        if (storeIndexes)
-            flatIndexes->push_back(flatIndexFor(indexes));
-        else {
-            if (variables[flatIndexFor(indexes)] != nullptr)
-                list.push_back(variables[flatIndexFor(indexes)]);
-        }
-    } while (incrementIndexes(indexes, ranges));
+        XVariable* x = variableAt(flatIndexFor(indexes));
+        if (x != nullptr)
+            list.push_back(x);
+    } while (incrementIndexes(indexes, first, last));
+}
+
+XVariable* XVariableArray::variableAt(const char* indexes, size_t size) {
+    size_t flat = 0, pos = 0;
+    for (int sz : sizes) {
+        if (pos == size || indexes[pos] != '[')
+            return NULL;
+        size_t index = 0, first = ++pos;
+        for (; pos < size && indexes[pos] >= '0' && indexes[pos] <= '9' && pos - first < 9; pos++)
+            index = 10 * index + (indexes[pos] - '0');
+        if (pos == first || pos == size || indexes[pos] != ']' || index >= static_cast<size_t>(sz))
+            return NULL;
+        pos++;
+        flat = flat * sz + index;
+    }
+    return pos == size ? variableAt(flat) : NULL;
+}
+
+XVariable* XVariableArray::variableAt(size_t flat) {
+    if (flat >= nbCells)
+        return NULL;
+    std::unique_lock<std::mutex> lock(owner->cellMutex, std::defer_lock);
+    if (owner->sharedCells)
+        lock.lock();
+    if (pages.empty())
+        pages.resize((nbCells + PAGE_SIZE - 1) / PAGE_SIZE);
+    std::unique_ptr<XVariable*[]>& page = pages[flat / PAGE_SIZE];
+    if (page == nullptr) {
+        page.reset(new XVariable*[PAGE_SIZE]);
+        std::fill(page.get(), page.get() + PAGE_SIZE, nullptr);
+    }
+    XVariable*& cell = page[flat % PAGE_SIZE];
+    if (cell == nullptr) {
+        XDomainInteger* domain = domainAt(flat);
+        if (domain == nullptr)
+            return NULL;
+        std::string name;
+        cellId(flat, name);
+        cell = owner->CellPool.make<XVariable>(owner->cellSymbols.intern(name), domain, handleAt(flat));
+    }
+    return cell;
 }
 
-void XVariableArray::buildVarsWith(XDomainInteger* domain) {
-    std::vector<int> indexes;
-    indexes.assign(sizes.size(), 0);
+void XVariableArray::addDomain(const std::string& compactForm, XDomainInteger* domain) {
+    Domains& own = ownDomains();
+    own.rules.push_back(Domains::Rule());
+    rangesFor(compactForm, own.rules.back().first, own.rules.back().last);
+    own.rules.back().domain = domain;
+}
 
-    for (unsigned int i = 0; i < variables.size(); i++) {
-        if (variables[i] == NULL) // We need to create a variable
-            variables[i] = DataPool::EntityPool.make<XVariable>(id, domain, indexes);
-        for (int j = sizes.size() - 1; j >= 0; j--)
-            if (++indexes[j] == sizes[j])
-                indexes[j] = 0;
-            else
+void XVariableArray::endDomains(XDomainInteger* others) {
+    Domains& own = ownDomains();
+    own.others = others;
+    if (own.rules.size() <= 8)
+        return;
+    // Too many rules to look at for each cell
+    own.cells.assign(nbCells, others);
+    for (Domains::Rule& rule : own.rules) {
+        std::vector<int> indexes(rule.first);
+        do
+            own.cells[flatIndexFor(indexes)] = rule.domain;
+        while (incrementIndexes(indexes, rule.first, rule.last));
+    }
+    std::vector<Domains::Rule>().swap(own.rules);
+}
+
+XDomainInteger* XVariableArray::domainAt(size_t flat) const {
+    if (!domains->cells.empty())
+        return domains->cells[flat];
+    for (size_t i = domains->rules.size(); i-- > 0;) {
+        const Domains::Rule& rule = domains->rules[i];
+        size_t rest = flat;
+        int j = sizes.size() - 1;
+        for (; j >= 0; j--) {
+            int index = rest % sizes[j];
+            rest /= sizes[j];
+            if (index < rule.first[j] || index > rule.last[j])
                 break;
+        }
+        if (j < 0)
+            return rule.domain;
+    }
+    return domains->others;
+}
+
+void XVariableArray::cellId(size_t flat, std::string& name) const {
+    char digits[16];
+    name.assign(id.data(), id.size());
+    size_t divisor = nbCells;
+    for (int sz : sizes) {
+        divisor /= sz;
+        name += '[';
+        name.append(digits, snprintf(digits, sizeof(digits), "%d", static_cast<int>(flat / divisor % sz)));
+        name += ']';
     }
 }
 
-int XVariableArray::flatIndexFor(std::vector<int> indexes) {
+void XVariableArray::setHandle(size_t flat, uint32_t handle) {
+    if (!pages.empty() && pages[flat / PAGE_SIZE] != nullptr && pages[flat / PAGE_SIZE][flat % PAGE_SIZE] != nullptr)
+        pages[flat / PAGE_SIZE][flat % PAGE_SIZE]->handle = handle;
+    if (!handles.empty() && handles.back().flat + handles.back().count == flat
+        && handles.back().handle + handles.back().count == handle)
+        handles.back().count++;
+    else
+        handles.push_back(HandleRun{flat, handle, 1});
+}
+
+uint32_t XVariableArray::handleAt(size_t flat) const {
+    std::vector<HandleRun>::const_iterator run = std::upper_bound(
+        handles.begin(), handles.end(), flat, [](size_t f, const HandleRun& r) { return f < r.flat; });
+    if (run == handles.begin() || flat >= (run - 1)->flat + (run - 1)->count)
+        return XVariable::NO_HANDLE;
+    run--;
+    return run->handle + static_cast<uint32_t>(flat - run->flat);
+}
+
+int XVariableArray::flatIndexFor(const std::vector<int>& indexes) {
     int sum = 0;
     for (int i = indexes.size() - 1, nb = 1; i >= 0; i--) {
         sum += indexes[i] * nb;
@@ -270,7 +552,7 @@ void XConstraintGroup::unfoldVector(std::vector<XVariable*>& toUnfold, std::vect
         return;
     }
     if (xp->number == -1) { // %...
-        toUnfold.assign(args.begin() + (XParameterVariable::max == -1 ? 0 : XParameterVariable::max + 1), args.end());
+        toUnfold.assign(args.begin() + (maxParameter == -1 ? 0 : maxParameter + 1), args.end());
         return;
     }
     for (XVariable* xv : initial) {
@@ -350,12 +632,12 @@ void XInitialCondition::extractCondition(XCondition& xc) { // Create the op and
     size_t dotdot = tmp1.find('.');
     if (dotdot != std::string::npos) { // Normal variable
         xc.operandType = OperandType::INTERVAL;
-        xc.min = stoi(tmp1.substr(0, dotdot));
-        xc.max = stoi(tmp1.substr(dotdot + 2));
+        xc.min = toInt(tmp1.substr(0, dotdot));
+        xc.max = toInt(tmp1.substr(dotdot + 2));
         return;
     }
     try {
-        xc.val = stoi(tmp1);
+        xc.val = toInt(tmp1);
         xc.operandType = OperandType::INTEGER;
     } catch (const std::invalid_argument& e) {
         xc.var = tmp1;
@@ -411,6 +693,24 @@ void XConstraintGroup::unfoldArgumentNumber(int i, XConstraint* builtConstraint)
     return;
 }
 
+void XConstraintRegular::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
+    XConstraint::unfoldParameters(group, arguments, original);
+    XConstraintRegular* xc = dynamic_cast<XConstraintRegular*>(original);
+    start = xc->start;
+    final = xc->final;
+    transitions = xc->transitions;
+}
+
+void XConstraintMDD::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
+    XConstraint::unfoldParameters(group, arguments, original);
+    transitions = dynamic_cast<XConstraintMDD*>(original)->transitions;
+}
+
+void XConstraintAllDiff::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
+    XConstraint::unfoldParameters(group, arguments, original);
+    except = dynamic_cast<XConstraintAllDiff*>(original)->except;
+}
+
 void XConstraintAllDiffMatrix::unfoldParameters(XConstraintGroup*, std::vector<XVariable*>&, XConstraint*) {
     throw std::runtime_error("Group Alldiff Matrix and list is not yet supported");
 }
@@ -418,10 +718,12 @@ void XConstraintAllDiffMatrix::unfoldParameters(XConstraintGroup*, std::vector<X
 void XConstraintOrdered::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XLengths::unfoldParameters(group, arguments, original);
+    op = dynamic_cast<XConstraintOrdered*>(original)->op;
 }
 
 void XConstraintLex::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
     XConstraintLex* xc = dynamic_cast<XConstraintLex*>(original);
+    op = xc->op;
     for (unsigned int i = 0; i < lists.size(); i++)
         group->unfoldVector(lists[i], arguments, xc->lists[i]);
 }
@@ -440,6 +742,7 @@ void XConstraintSum::unfoldParameters(XConstraintGroup* group, std::vector<XVari
 void XConstraintNValues::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
     XConstraint::unfoldParameters(group, arguments, original);
     XInitialCondition::unfoldParameters(group, arguments, original);
+    except = dynamic_cast<XConstraintNValues*>(original)->except;
 }
 
 void XConstraintCardinality::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
@@ -527,6 +830,11 @@ void XConstraintCircuit::unfoldParameters(XConstraintGroup* group, std::vector<X
     startIndex = xc->startIndex;
 }
 
+void XConstraintInstantiation::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
+    XConstraint::unfoldParameters(group, arguments, original);
+    values = dynamic_cast<XConstraintInstantiation*>(original)->values;
+}
+
 void XConstraintClause::unfoldParameters(XConstraintGroup* group, std::vector<XVariable*>& arguments, XConstraint* original) {
     (void)group;
     (void)original;
@@ -535,7 +843,7 @@ void XConstraintClause::unfoldParameters(XConstraintGroup* group, std::vector<XV
             if (xv->id.rfind("not(", 0) != 0)
                 throw std::runtime_error("a clause is malformed in a group: " + xv->id);
             std::string name = xv->id.substr(4, xv->id.length() - 5);
-            negative.push_back(DataPool::EntityPool.make<XVariable>(name, nullptr)); // TODO: improvements needed here
+            negative.push_back(DataPool::current().EntityPool.make<XVariable>(name, nullptr)); // TODO: improvements needed here
         } else {
             positive.push_back(xv);
         }
@@ -583,6 +891,22 @@ std::string& XCSP3Core::rtrim(std::string& s) {
     return s;
 }
 
+int XCSP3Core::toInt(const std::string& s) {
+    const char* b = s.data();
+    const char* e = b + s.size();
+    while (b != e && isspace(static_cast<unsigned char>(*b)))
+        ++b;
+    while (e != b && isspace(static_cast<unsigned char>(e[-1])))
+        --e;
+    int v;
+    if (parseInt(b, e, v))
+        return v;
+    const char* digits = (b != e && (*b == '-' || *b == '+')) ? b + 1 : b;
+    if (digits != e && std::all_of(digits, e, [](char c) { return c >= '0' && c <= '9'; }))
+        throw std::out_of_range("Integer out of range: " + s);
+    throw std::invalid_argument("Integer expected: " + s);
+}
+
 std::string& XCSP3Core::removeChar(std::string& s, char c) {
     std::string::size_type begin = s.find_first_not_of(c);
     std::string::size_type end = s.find_last_not_of(c);
@@ -600,3 +924,58 @@ std::string& XCSP3Core::trim(std::string& s) {
     s = removeChar(s, 1);
     return s;
 }
+
+//------------------------------------------------------------------------------------------
+//  XEntityTable
+//------------------------------------------------------------------------------------------
+
+size_t XEntityTable::slotOf(const char* name, size_t size, uint32_t hash) const {
+    size_t mask = slots.size() - 1;
+    size_t i = hash & mask;
+    for (; slots[i] != NULL; i = (i + 1) & mask)
+        if (slots[i]->id.hash() == hash && slots[i]->id.equals(name, size))
+            break;
+    return i;
+}
+
+void XEntityTable::rehash() {
+    std::vector<XEntity*> old(std::max(static_cast<size_t>(256), 2 * slots.size()), NULL);
+    old.swap(slots);
+    size_t mask = slots.size() - 1;
+    for (XEntity* entity : old) {
+        if (entity == NULL)
+            continue;
+        size_t i = entity->id.hash() & mask;
+        while (slots[i] != NULL)
+            i = (i + 1) & mask;
+        slots[i] = entity;
+    }
+}
+
+void XEntityTable::add(XEntity* entity) {
+    if (4 * (count + 1) > 3 * slots.size())
+        rehash();
+    size_t i = slotOf(entity->id.data(), entity->id.size(), entity->id.hash());
+    if (slots[i] == NULL)
+        count++;
+    slots[i] = entity;
+}
+
+XEntity* XEntityTable::find(const char* name, size_t size) const {
+    if (count > 0) {
+        XEntity* entity = slots[slotOf(name, size, Symbol::hash(name, size))];
+        if (entity != NULL)
+            return entity;
+    }
+    const char* bracket = static_cast<const char*>(memchr(name, '[', size));
+    if (bracket == NULL || bracket == name)
+        return NULL;
+    size_t length = bracket - name;
+    XVariableArray* array = dynamic_cast<XVariableArray*>(find(name, length));
+    return array == NULL ? NULL : array->variableAt(bracket, size - length);
+}
+
+void XEntityTable::clear() {
+    std::fill(slots.begin(), slots.end(), static_cast<XEntity*>(NULL));
+    count = 0;
+}
@@ -24,6 +24,22 @@
  *=============================================================================
  */
 #include "XCSP3CoreParser.h"
+#include "XCSP3Decompressor.h"
+#include "XCSP3RecordingManager.h"
+#include "XMLTokenizer.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
 
 using namespace XCSP3Core;
 
@@ -36,11 +52,784 @@ namespace XCSP3Core {
     }
 } // namespace XCSP3Core
 
+namespace {
+    const int bufSize = (1 << 20);
+
+    /**
+     * A read-only mapping of a whole regular file.
+     * The mapping is empty when the file can not be mapped (pipe, empty file...).
+     */
+    class MappedFile {
+    public:
+        const char* data;
+        size_t size;
+
+        MappedFile(int fd, bool hugePages) : data(nullptr), size(0) {
+            struct stat st;
+            if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+                return;
+
+            void* addr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED)
+                return;
+
+            data = static_cast<const char*>(addr);
+            size = st.st_size;
+            madvise(addr, size, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+            if (hugePages)
+                madvise(addr, size, MADV_HUGEPAGE);
+#else
+            (void)hugePages;
+#endif
+        }
+
+        ~MappedFile() {
+            if (data != nullptr)
+                munmap(const_cast<char*>(data), size);
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+    };
+
+    /**
+     * Close the file descriptor when going out of scope
+     */
+    class FileDescriptor {
+        int fd;
+
+    public:
+        explicit FileDescriptor(int f) : fd(f) {}
+
+        ~FileDescriptor() {
+            close(fd);
+        }
+
+        FileDescriptor(const FileDescriptor&) = delete;
+        FileDescriptor& operator=(const FileDescriptor&) = delete;
+    };
+
+    /**
+     * Read a file sequentially: with pread on regular files, with read on pipes and devices.
+     * Each call fills the buffer, except at the end of the file.
+     */
+    class FileReader {
+        int fd;
+        off_t offset;
+        bool seekable;
+
+    public:
+        explicit FileReader(int f) : fd(f), offset(0), seekable(false) {
+            struct stat st;
+            seekable = fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+#ifdef POSIX_FADV_SEQUENTIAL
+            if (seekable)
+                posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+        }
+
+        size_t operator()(char* buffer, size_t size) {
+            size_t done = 0;
+            while (done < size) {
+                ssize_t n = seekable ? pread(fd, buffer + done, size - done, offset) : read(fd, buffer + done, size - done);
+                if (n < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    throw std::runtime_error(std::string("Unable to read the file: ") + strerror(errno));
+                }
+                if (n == 0)
+                    break;
+                done += n;
+                offset += n;
+            }
+            return done;
+        }
+    };
+
+    /**
+     * A reader thread fills a ring of chunks ahead of the parser.
+     * The parser takes the chunks in order with next() and gives each one back with release().
+     * An exception raised by the reader thread is rethrown by next().
+     */
+    class PrefetchReader {
+        std::function<size_t(char*, size_t)> read;
+        std::vector<std::unique_ptr<char[]>> chunks;
+        std::vector<size_t> sizes;
+        size_t chunkSize;
+        size_t produced, consumed; // number of chunks filled by the reader / released by the parser
+        bool ended, stopped;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable filled, released;
+        std::thread thread;
+
+        void run() {
+            try {
+                for (;;) {
+                    char* chunk;
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        released.wait(lock, [this] { return stopped || produced - consumed < chunks.size(); });
+                        if (stopped)
+                            return;
+                        chunk = chunks[produced % chunks.size()].get();
+                    }
+                    size_t size = read(chunk, chunkSize);
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (size == 0)
+                        ended = true;
+                    else
+                        sizes[produced++ % chunks.size()] = size;
+                    filled.notify_one();
+                    if (ended)
+                        return;
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                error = std::current_exception();
+                ended = true;
+                filled.notify_one();
+            }
+        }
+
+    public:
+        PrefetchReader(const std::function<size_t(char*, size_t)>& r, size_t size, int depth)
+            : read(r), sizes(depth), chunkSize(size), produced(0), consumed(0), ended(false), stopped(false) {
+            for (int i = 0; i < depth; i++)
+                chunks.emplace_back(new char[size]);
+            thread = std::thread(&PrefetchReader::run, this);
+        }
+
+        ~PrefetchReader() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped = true;
+                released.notify_one();
+            }
+            thread.join();
+        }
+
+        PrefetchReader(const PrefetchReader&) = delete;
+        PrefetchReader& operator=(const PrefetchReader&) = delete;
+
+        bool next(const char*& data, size_t& size) {
+            std::unique_lock<std::mutex> lock(mutex);
+            filled.wait(lock, [this] { return ended || produced > consumed; });
+            if (produced > consumed) {
+                data = chunks[consumed % chunks.size()].get();
+                size = sizes[consumed % chunks.size()];
+                return true;
+            }
+            if (error)
+                std::rethrow_exception(error);
+            return false;
+        }
+
+        void release() {
+            std::lock_guard<std::mutex> lock(mutex);
+            consumed++;
+            released.notify_one();
+        }
+    };
+
+    /**
+     * Thrown between two chunks to stop a parse, with the value returned by parse
+     */
+    struct ParseStopped {
+        int status;
+    };
+
+    /**
+     * Follow the progress of a parse: report it (see XCSP3CoreParser::progress) and stop
+     * the parse, by throwing ParseStopped, when it is cancelled or out of time.
+     */
+    class ParseMonitor {
+        const XCSP3CoreParser& options;
+        const XMLParser& parser;
+        XCSP3Progress& reached;
+        std::chrono::steady_clock::time_point start;
+        size_t nextReport;
+
+        void update() {
+            reached.section = parser.section();
+            reached.constraints = parser.nbConstraints;
+            reached.elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+
+    public:
+        ParseMonitor(XCSP3CoreParser& o, const XMLParser& p, size_t total)
+            : options(o), parser(p), reached(o.reached), start(std::chrono::steady_clock::now()), nextReport(0) {
+            reached = XCSP3Progress();
+            reached.total = total;
+        }
+
+        /**
+         * true if the parse must be followed (the native tokenizer can not be)
+         */
+        bool active() const {
+            return options.progress || options.cancel != nullptr || options.timeLimit > 0;
+        }
+
+        /**
+         * the largest chunk to parse between two checks
+         */
+        size_t step() const {
+            return options.progress ? std::max(options.progressStep, static_cast<size_t>(1)) : static_cast<size_t>(bufSize);
+        }
+
+        void advance(size_t bytes) {
+            reached.bytes += bytes;
+            check();
+        }
+
+        void check() {
+            if (!active())
+                return;
+            update();
+            if (options.cancel != nullptr && options.cancel->load())
+                throw ParseStopped{XCSP3CoreParser::CANCELLED};
+            if (options.timeLimit > 0 && reached.elapsed > options.timeLimit)
+                throw ParseStopped{XCSP3CoreParser::TIMEOUT};
+            if (options.progress && reached.bytes >= nextReport) {
+                options.progress(reached);
+                nextReport = reached.bytes + step();
+            }
+        }
+
+        void finish() {
+            update();
+            if (reached.total != 0)
+                reached.bytes = reached.total;
+            if (options.progress)
+                options.progress(reached);
+        }
+    };
+
+    /**
+     * Give a document to the libxml2 push parser chunk by chunk.
+     * The parser context is created with the first chunk, or taken from kept and reset. At the end
+     * of a successful parse, the context is given back to kept (if any) instead of being freed.
+     */
+    class ChunkParser {
+        xmlSAXHandler* handler;
+        void* userData;
+        ParseMonitor* monitor;  // checked after each chunk, if any
+        xmlParserCtxtPtr* kept; // a context kept from one parse to the next, if any
+        xmlParserCtxtPtr ctxt;
+
+        void start(const char* data, int size) {
+            if (kept != nullptr && *kept != nullptr) {
+                std::swap(ctxt, *kept);
+                xmlCtxtResetPush(ctxt, data, size, nullptr, nullptr);
+            } else
+                ctxt = xmlCreatePushParserCtxt(handler, userData, data, size, nullptr);
+        }
+
+    public:
+        ChunkParser(xmlSAXHandler* h, void* data, ParseMonitor* m = nullptr, xmlParserCtxtPtr* k = nullptr)
+            : handler(h), userData(data), monitor(m), kept(k), ctxt(nullptr) {}
+
+        ~ChunkParser() {
+            if (ctxt != nullptr)
+                xmlFreeParserCtxt(ctxt);
+        }
+
+        ChunkParser(const ChunkParser&) = delete;
+        ChunkParser& operator=(const ChunkParser&) = delete;
+
+        void push(const char* data, size_t size) {
+            size_t maxChunk = monitor ? std::min(monitor->step(), static_cast<size_t>(bufSize)) : bufSize;
+            while (size > 0) {
+                int chunk = static_cast<int>(std::min(size, maxChunk));
+                if (ctxt == nullptr)
+                    start(data, chunk);
+                else
+                    xmlParseChunk(ctxt, data, chunk, 0);
+                data += chunk;
+                size -= chunk;
+                if (monitor)
+                    monitor->advance(chunk);
+            }
+        }
+
+        /**
+         * Parse the data pushed so far, as far as possible (the first chunk is only
+         * parsed with the next one otherwise)
+         */
+        void flush() {
+            if (ctxt != nullptr)
+                xmlParseChunk(ctxt, nullptr, 0, 0);
+        }
+
+        void finish() {
+            if (ctxt == nullptr) // empty document
+                return;
+            xmlParseChunk(ctxt, nullptr, 0, 1);
+            if (kept != nullptr && *kept == nullptr)
+                std::swap(ctxt, *kept);
+            else
+                xmlFreeParserCtxt(ctxt);
+            ctxt = nullptr;
+        }
+
+        void printErrorLine() const {
+            if (ctxt && ctxt->input)
+                std::cout << "c Exception at line " << ctxt->input->line << std::endl;
+            else
+                std::cout << "c Exception at undefined line" << std::endl;
+        }
+    };
+
+    /**
+     * The raw input of the parser. The format is detected on the first chunk:
+     * compressed documents are decompressed on the fly before being parsed.
+     */
+    class InputStream {
+        ChunkParser& parser;
+        std::unique_ptr<XCSP3Decompressor> decompressor;
+        XCSP3Decompressor::Output output;
+        bool started;
+
+    public:
+        explicit InputStream(ChunkParser& p) : parser(p), started(false) {
+            output = [this](const char* data, size_t size) { parser.push(data, size); };
+        }
+
+        void push(const char* data, size_t size) {
+            if (!started) {
+                started = true;
+                decompressor = XCSP3Decompressor::create(XCSP3Decompressor::detect(data, size));
+            }
+            if (decompressor)
+                decompressor->decompress(data, size, output);
+            else
+                parser.push(data, size);
+        }
+
+        void finish() {
+            if (decompressor)
+                decompressor->finish(output);
+            parser.finish();
+        }
+    };
+
+    /**
+     * Consecutive top-level constraints of an instance, parsed by a worker thread.
+     * The calls of the worker to its manager are recorded, with the objects they refer to.
+     */
+    struct Shard {
+        size_t begin, end; // byte range of the constraints in the document
+        std::vector<XCSP3RecordingManager::Call> calls;
+        std::unique_ptr<DataPool> objects;
+        std::exception_ptr error;
+        size_t nbConstraints;
+        bool parsed;
+
+        Shard(size_t b, size_t e) : begin(b), end(e), nbConstraints(0), parsed(false) {}
+    };
+
+    /**
+     * While the workers are alive, they may create the cells of the arrays of the calling
+     * thread, which are then created under the lock (see XVariableArray::variableAt)
+     */
+    class SharedCells {
+        DataPool& pool;
+
+    public:
+        explicit SharedCells(DataPool& p) : pool(p) {
+            pool.sharedCells = true;
+        }
+
+        ~SharedCells() {
+            pool.sharedCells = false;
+        }
+
+        SharedCells(const SharedCells&) = delete;
+        SharedCells& operator=(const SharedCells&) = delete;
+    };
+
+    /**
+     * Parse shards with a pool of worker threads. Each worker has its own XMLParser,
+     * with a copy of the variables, and its own pools. The shards are given back to the
+     * calling thread in the document order, or as soon as they are parsed.
+     */
+    class ShardParser {
+        const char* data;
+        const std::vector<std::pair<size_t, size_t>>& header; // the start tags which enclose the constraints
+        const std::string& footer;                            // and the end tags
+        std::vector<Shard>& shards;
+        XCSP3CoreCallbacksBase* callback;
+        const XEntityTable& variables;
+        xmlSAXHandler handler;
+        bool trusted;
+
+        size_t next, delivered; // next shard to parse, number of shards given back
+        std::deque<size_t> ready; // parsed shards, in parsing order
+        bool stopped;
+        std::mutex mutex;
+        std::condition_variable parsed;
+        std::vector<std::thread> threads;
+
+        void run() {
+            XMLParser parser(callback);
+            DataPool::Scope scope(parser.pool);
+            parser.variablesList = variables;
+            parser.trusted = trusted;
+            XCSP3RecordingManager* recorder = new XCSP3RecordingManager(callback, parser.variablesList);
+            parser.manager.reset(recorder);
+            xmlSAXHandler saxHandler = handler;
+            xmlSubstituteEntitiesDefault(1);
+
+            for (;;) {
+                size_t i;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (stopped || next == shards.size())
+                        return;
+                    i = next++;
+                }
+                Shard& shard = shards[i];
+                try {
+                    ChunkParser chunkParser(&saxHandler, &parser);
+                    for (const std::pair<size_t, size_t>& slice : header)
+                        chunkParser.push(data + slice.first, slice.second - slice.first);
+                    chunkParser.push(data + shard.begin, shard.end - shard.begin);
+                    chunkParser.push(footer.data(), footer.size());
+                    chunkParser.finish();
+                } catch (...) {
+                    shard.error = std::current_exception();
+                }
+                shard.calls.swap(recorder->calls);
+                recorder->calls.clear();
+                shard.nbConstraints = parser.nbConstraints;
+                shard.objects.reset(new DataPool());
+                shard.objects->swap(parser.pool);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                shard.parsed = true;
+                ready.push_back(i);
+                parsed.notify_all();
+            }
+        }
+
+    public:
+        ShardParser(const char* d, const std::vector<std::pair<size_t, size_t>>& h, const std::string& f, std::vector<Shard>& s,
+                    XCSP3CoreCallbacksBase* cb, const XEntityTable& vars, const xmlSAXHandler& sax, bool t, int nbThreads)
+            : data(d), header(h), footer(f), shards(s), callback(cb), variables(vars), handler(sax), trusted(t), next(0), delivered(0),
+              stopped(false) {
+            for (int i = 0; i < nbThreads; i++)
+                threads.emplace_back(&ShardParser::run, this);
+        }
+
+        ~ShardParser() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopped = true;
+            }
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+
+        ShardParser(const ShardParser&) = delete;
+        ShardParser& operator=(const ShardParser&) = delete;
+
+        /**
+         * Wait for the next shard: the next one in the document if ordered is true,
+         * otherwise the next one to have been parsed
+         */
+        Shard& nextParsed(bool ordered) {
+            std::unique_lock<std::mutex> lock(mutex);
+            size_t i;
+            if (ordered) {
+                i = delivered;
+                parsed.wait(lock, [this, i] { return shards[i].parsed; });
+            } else {
+                parsed.wait(lock, [this] { return !ready.empty(); });
+                i = ready.front();
+                ready.pop_front();
+            }
+            delivered++;
+            return shards[i];
+        }
+    };
+} // namespace
+
+const int XCSP3CoreParser::COMPLETE;
+const int XCSP3CoreParser::CANCELLED;
+const int XCSP3CoreParser::TIMEOUT;
+
+XCSP3CoreParser::~XCSP3CoreParser() {
+    if (context != nullptr)
+        xmlFreeParserCtxt(context);
+}
+
+void XCSP3CoreParser::prepare() {
+    cspParser.trusted = trusted;
+    cspParser.threads = threads;
+    cspParser.nbConstraints = 0;
+    cspParser.forgetDocument();
+    cspParser.pool.useHugePages(hugePages);
+}
+
+void XCSP3CoreParser::releaseObjects() {
+    if (leakObjects)
+        cspParser.pool.leak();
+    else if (warm)
+        cspParser.pool.reset();
+    else
+        cspParser.pool.clear();
+}
+
 int XCSP3CoreParser::parse(const char* filename) {
-    std::ifstream in(filename);
-    if (!in.good())
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
         throw std::runtime_error("Path filename does not exist");
-    return parse(in);
+    FileDescriptor file(fd);
+
+    if (!prefetch) {
+        MappedFile mapping(fd, hugePages);
+        if (mapping.data != nullptr)
+            return parse(mapping.data, mapping.size);
+    }
+
+    // Not mapped (prefetch, pipe, empty file): read it chunk by chunk
+    return parseSource(FileReader(fd));
+}
+
+void XCSP3CoreParser::initHandler(xmlSAXHandler& handler) {
+    // SAX2: element names are interned in the dictionary of the parser context,
+    // which allows XMLParser to find the tag action of a name only once
+    xmlSAXVersion(&handler, 2);
+
+    handler.startDocument = startDocument;
+    handler.endDocument = endDocument;
+    handler.characters = characters;
+    handler.startElementNs = startElementNs;
+    handler.endElementNs = endElementNs;
+    handler.comment = comment;
+}
+
+void XCSP3CoreParser::initLibrary() {
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        LIBXML_TEST_VERSION
+    });
+}
+
+int XCSP3CoreParser::parse(const void* data, size_t size) {
+    const char* buffer = static_cast<const char*>(data);
+    prepare();
+
+    if (threads > 1 && XCSP3Decompressor::detect(buffer, size) == XCSP3Decompressor::Format::NONE)
+        return parseInParallel(buffer, size);
+
+    // the native tokenizer parses the document at once: it is not used when the parse is followed
+    if (nativeTokenizer && XCSP3Decompressor::detect(buffer, size) == XCSP3Decompressor::Format::NONE
+        && XMLTokenizer::handles(buffer, size)) {
+        ParseMonitor monitor(*this, cspParser, size);
+        if (!monitor.active()) {
+            ObjectsRelease release(*this);
+            DataPool::Scope scope(cspParser.pool);
+            XMLTokenizer tokenizer(&cspParser);
+            try {
+                tokenizer.parse(buffer, size);
+            } catch (...) {
+                std::cout << "c Exception at line " << tokenizer.line() << std::endl;
+                throw;
+            }
+            monitor.finish();
+            return COMPLETE;
+        }
+    }
+    return parseSlices(buffer, {std::make_pair(static_cast<size_t>(0), size)});
+}
+
+XCSP3Index XCSP3CoreParser::buildIndex(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Path filename does not exist");
+    FileDescriptor file(fd);
+
+    MappedFile mapping(fd, false);
+    if (mapping.data == nullptr)
+        throw std::runtime_error("Only regular files can be indexed");
+    if (XCSP3Decompressor::detect(mapping.data, mapping.size) != XCSP3Decompressor::Format::NONE)
+        throw std::runtime_error("Compressed files can not be indexed");
+    return XCSP3Index::build(mapping.data, mapping.size);
+}
+
+int XCSP3CoreParser::parse(const char* filename, const XCSP3Index& index, const XCSP3Index::Filter& select) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Path filename does not exist");
+    FileDescriptor file(fd);
+
+    MappedFile mapping(fd, hugePages);
+    if (mapping.data == nullptr || mapping.size != index.size)
+        throw std::runtime_error("The index does not match the file");
+    if (index.entries.empty() || index.entries[0].level != 0)
+        throw std::runtime_error("The index has no root element");
+
+    // The document given to the parser: the root start tag, the variables,
+    // the selected constraints within <constraints>, and the root end tag
+    const std::vector<XCSP3Index::Entry>& entries = index.entries;
+    std::vector<std::pair<size_t, size_t>> slices;
+    slices.push_back(std::make_pair(static_cast<size_t>(0), entries[0].contentBegin));
+    for (size_t i = 1; i < entries.size(); i++) {
+        const XCSP3Index::Entry& entry = entries[i];
+        if (entry.level != 1)
+            continue;
+        if (entry.tag == "variables")
+            slices.push_back(std::make_pair(entry.begin, entry.end));
+        if (entry.tag == "constraints") {
+            slices.push_back(std::make_pair(entry.begin, entry.contentBegin));
+            for (size_t j = i + 1; j < entries.size() && entries[j].level == 2; j++)
+                if (select(entries[j]))
+                    slices.push_back(std::make_pair(entries[j].begin, entries[j].end));
+            slices.push_back(std::make_pair(entry.contentEnd, entry.end));
+        }
+    }
+    slices.push_back(std::make_pair(entries[0].contentEnd, mapping.size));
+
+    return parseSlices(mapping.data, slices);
+}
+
+int XCSP3CoreParser::parseInParallel(const char* data, size_t size) {
+    XCSP3Index index = XCSP3Index::build(data, size);
+    const std::vector<XCSP3Index::Entry>& entries = index.entries;
+
+    // the top-level constraints are the entries [first, last)
+    size_t constraints = 0, first = 0, last = 0;
+    for (size_t i = 1; i < entries.size() && constraints == 0; i++)
+        if (entries[i].level == 1 && entries[i].tag == "constraints") {
+            constraints = i;
+            for (first = last = i + 1; last < entries.size() && entries[last].level == 2; last++)
+                ;
+        }
+    if (last - first < 2)
+        return parseSlices(data, {std::make_pair(static_cast<size_t>(0), size)});
+
+    // released once the workers are stopped
+    ObjectsRelease release(*this);
+
+    // several shards per thread, of about the same size, balance the load
+    std::vector<Shard> shards;
+    size_t nbShards = std::min(last - first, static_cast<size_t>(threads) * 8);
+    size_t total = entries[last - 1].end - entries[first].begin;
+    size_t begin = first;
+    for (size_t i = first; i < last; i++) {
+        size_t done = entries[i].end - entries[first].begin;
+        if (i + 1 == last || done >= total / nbShards * (shards.size() + 1)) {
+            shards.push_back(Shard(entries[begin].begin, entries[i].end));
+            begin = i + 1;
+        }
+    }
+
+    // the workers parse each shard enclosed in the start and end tags of the root and of <constraints>
+    std::vector<std::pair<size_t, size_t>> header;
+    header.push_back(std::make_pair(static_cast<size_t>(0), entries[0].contentBegin));
+    header.push_back(std::make_pair(entries[constraints].begin, entries[constraints].contentBegin));
+    std::string footer = "</" + entries[constraints].tag + "></" + entries[0].tag + ">";
+
+    xmlSAXHandler handler;
+    initHandler(handler);
+
+    DataPool::Scope scope(cspParser.pool);
+    ParseMonitor monitor(*this, cspParser, size);
+    ChunkParser parser(&handler, &cspParser, &monitor, warm ? &context : nullptr);
+
+    try {
+        xmlSubstituteEntitiesDefault(1);
+
+        // this thread parses everything up to <constraints> (the variables)...
+        parser.push(data, entries[constraints].contentBegin);
+        parser.flush();
+        if (cspParser.getParentTagAction(0) == nullptr || cspParser.getParentTagAction(0)->type != TagType::CONSTRAINTS)
+            throw std::runtime_error("<constraints> expected before parsing the constraints in parallel");
+    } catch (const ParseStopped& stopped) {
+        return stopped.status;
+    } catch (...) {
+        parser.printErrorLine();
+        throw;
+    }
+
+    // ...replays the constraints recorded by the workers...
+    SharedCells sharedCells(cspParser.pool);
+    ShardParser shardParser(data, header, footer, shards, cspParser.manager->callback, cspParser.variablesList, handler, trusted, threads);
+    for (size_t i = 0; i < shards.size(); i++) {
+        Shard& shard = shardParser.nextParsed(!outOfOrder);
+        try {
+            if (shard.error)
+                std::rethrow_exception(shard.error);
+            for (XCSP3RecordingManager::Call& call : shard.calls)
+                call(*cspParser.manager);
+        } catch (...) {
+            std::cout << "c Exception in the constraints from line " << 1 + std::count(data, data + shard.begin, '\n') << std::endl;
+            throw;
+        }
+        shard.calls.clear();
+        if (leakObjects)
+            shard.objects->leak();
+        shard.objects.reset();
+        cspParser.nbConstraints += shard.nbConstraints;
+        try {
+            monitor.advance(shard.end - shard.begin);
+        } catch (const ParseStopped& stopped) {
+            return stopped.status; // the workers end with their current shard
+        }
+    }
+
+    // ...and parses the end of the document
+    try {
+        parser.push(data + entries[constraints].contentEnd, size - entries[constraints].contentEnd);
+        parser.finish();
+    } catch (const ParseStopped& stopped) {
+        return stopped.status;
+    } catch (...) {
+        parser.printErrorLine();
+        throw;
+    }
+    monitor.finish();
+    return COMPLETE;
+}
+
+int XCSP3CoreParser::parseSlices(const char* data, const std::vector<std::pair<size_t, size_t>>& slices) {
+    prepare();
+    ObjectsRelease release(*this);
+
+    xmlSAXHandler handler;
+    initHandler(handler);
+
+    size_t total = 0;
+    for (const std::pair<size_t, size_t>& slice : slices)
+        total += slice.second - slice.first;
+    bool compressed = !slices.empty() && slices[0].first < slices[0].second
+                      && XCSP3Decompressor::detect(data + slices[0].first, slices[0].second - slices[0].first) != XCSP3Decompressor::Format::NONE;
+
+    DataPool::Scope scope(cspParser.pool);
+    ParseMonitor monitor(*this, cspParser, compressed ? 0 : total);
+    ChunkParser parser(&handler, &cspParser, &monitor, warm ? &context : nullptr);
+    InputStream input(parser);
+
+    try {
+        xmlSubstituteEntitiesDefault(1);
+
+        // The buffer is given to libxml2 by slices: libxml2 copies each chunk in its
+        // own input buffer, which therefore never holds the whole document.
+        for (const std::pair<size_t, size_t>& slice : slices)
+            for (size_t pos = slice.first; pos < slice.second; pos += bufSize)
+                input.push(data + pos, std::min(slice.second - pos, static_cast<size_t>(bufSize)));
+
+        input.finish();
+    } catch (const ParseStopped& stopped) {
+        return stopped.status;
+    } catch (...) {
+        parser.printErrorLine();
+        throw;
+    }
+    monitor.finish();
+    return COMPLETE;
 }
 
 int XCSP3CoreParser::parse(std::istream& in) {
@@ -55,57 +844,60 @@ int XCSP3CoreParser::parse(std::istream& in) {
      * We also use the push mode to be able to read from any C++
      * stream.
      */
-    const char* filename = NULL; // name of the input file
-    xmlSAXHandler handler;
-    xmlParserCtxtPtr parserCtxt = nullptr;
-
-    const int bufSize = (1 << 20);
-    std::unique_ptr<char[]> buffer{new char[bufSize]};
+    return parseSource([&in](char* buffer, size_t size) -> size_t {
+        if (!in.good())
+            return 0;
+        in.read(buffer, size);
+        return in.gcount();
+    });
+}
 
-    int size;
+int XCSP3CoreParser::parseSource(const Source& read) {
+    prepare();
+    ObjectsRelease release(*this);
+    xmlSAXHandler handler;
+    initHandler(handler);
 
-    xmlSAXVersion(&handler, 1); // use SAX1 for now ???
+    DataPool::Scope scope(cspParser.pool);
+    ParseMonitor monitor(*this, cspParser, 0);
+    ChunkParser parser(&handler, &cspParser, &monitor, warm ? &context : nullptr);
+    InputStream input(parser);
 
-    handler.startDocument = startDocument;
-    handler.endDocument = endDocument;
-    handler.characters = characters;
-    handler.startElement = startElement;
-    handler.endElement = endElement;
-    handler.comment = comment;
+    size_t chunk = std::max(chunkSize, static_cast<size_t>(4096));
 
     try {
         xmlSubstituteEntitiesDefault(1);
 
-        in.read(buffer.get(), bufSize);
-        size = in.gcount();
-
-        if (size > 0) {
-            parserCtxt = xmlCreatePushParserCtxt(&handler, &cspParser, buffer.get(), size, filename);
-
-            while (in.good()) {
-                in.read(buffer.get(), bufSize);
-                size = in.gcount();
-
-                if (size > 0)
-                    xmlParseChunk(parserCtxt, buffer.get(), size, 0);
+        if (prefetch) {
+            PrefetchReader reader(read, chunk, std::max(queueDepth, 2));
+            const char* data;
+            size_t size;
+            while (reader.next(data, size)) {
+                input.push(data, size);
+                reader.release();
             }
-
-            xmlParseChunk(parserCtxt, buffer.get(), 0, 1);
-
-            xmlFreeParserCtxt(parserCtxt);
-
-            xmlCleanupParser();
+        } else {
+            std::unique_ptr<char[]> buffer(std::move(readBuffer));
+            if (!buffer || readBufferSize != chunk) {
+                buffer.reset(new char[chunk]);
+                readBufferSize = chunk;
+            }
+            size_t size;
+            while ((size = read(buffer.get(), chunk)) > 0)
+                input.push(buffer.get(), size);
+            if (warm)
+                readBuffer = std::move(buffer);
         }
+
+        input.finish();
+    } catch (const ParseStopped& stopped) {
+        return stopped.status;
     } catch (...) {
-        // ???
-        if (parserCtxt && parserCtxt->input)
-            std::cout << "c Exception at line " << parserCtxt->input->line << std::endl;
-        else
-            std::cout << "c Exception at undefined line" << std::endl;
+        parser.printErrorLine();
         throw;
     }
-    DataPool::clear();
-    return 0;
+    monitor.finish();
+    return COMPLETE;
 }
 
 // void *parser, const xmlChar *value
@@ -123,11 +915,15 @@ void XCSP3CoreParser::characters(void* parser, const xmlChar* ch, int len) {
     static_cast<XMLParser*>(parser)->characters(UTF8String(ch, ch + len));
 }
 
-void XCSP3CoreParser::startElement(void* parser, const xmlChar* name, const xmlChar** attr) {
-    AttributeList attributes(attr);
-    static_cast<XMLParser*>(parser)->startElement(UTF8String(name), attributes);
+// void *parser, const xmlChar *localname, const xmlChar *prefix, const xmlChar *URI,
+// int nb_namespaces, const xmlChar **namespaces, int nb_attributes, int nb_defaulted, const xmlChar **attributes
+void XCSP3CoreParser::startElementNs(void* parser, const xmlChar* localname, const xmlChar*, const xmlChar*, int, const xmlChar**,
+                                     int nb_attributes, int, const xmlChar** attributes) {
+    AttributeList attrs(attributes, nb_attributes);
+    static_cast<XMLParser*>(parser)->startElement(localname, attrs);
 }
 
-void XCSP3CoreParser::endElement(void* parser, const xmlChar* name) {
-    static_cast<XMLParser*>(parser)->endElement(UTF8String(name));
+// void *parser, const xmlChar *localname, const xmlChar *prefix, const xmlChar *URI
+void XCSP3CoreParser::endElementNs(void* parser, const xmlChar*, const xmlChar*, const xmlChar*) {
+    static_cast<XMLParser*>(parser)->endElement();
 }
@@ -0,0 +1,230 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3Decompressor.h"
+#include <cstring>
+#include <stdexcept>
+
+#ifdef XCSP3_HAVE_ZLIB
+#define ZLIB_CONST
+#include <zlib.h>
+#endif
+#ifdef XCSP3_HAVE_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef XCSP3_HAVE_LZMA
+#include <lzma.h>
+#endif
+
+using namespace XCSP3Core;
+
+typedef unsigned char Byte;
+
+XCSP3Decompressor::Format XCSP3Decompressor::detect(const char* data, size_t size) {
+    const Byte* b = reinterpret_cast<const Byte*>(data);
+
+    if (size >= 2 && b[0] == 0x1F && b[1] == 0x8B)
+        return Format::GZIP;
+    if (size >= 3 && b[0] == 'B' && b[1] == 'Z' && b[2] == 'h')
+        return Format::BZIP2;
+    if (size >= 6 && b[0] == 0xFD && b[1] == '7' && b[2] == 'z' && b[3] == 'X' && b[4] == 'Z' && b[5] == 0x00)
+        return Format::XZ;
+    // The legacy .lzma format has no magic number: its header starts with the properties
+    // byte (0x5D for the default settings), which can't start a XML document anyway.
+    if (size >= 13 && b[0] == 0x5D && (b[12] == 0x00 || b[12] == 0xFF))
+        return Format::LZMA;
+    return Format::NONE;
+}
+
+namespace {
+#ifdef XCSP3_HAVE_ZLIB
+    class GzipDecompressor : public XCSP3Decompressor {
+        z_stream stream;
+        std::unique_ptr<char[]> out;
+        bool ended;
+
+    public:
+        GzipDecompressor() : out(new char[outSize]), ended(false) {
+            std::memset(&stream, 0, sizeof(stream));
+            if (inflateInit2(&stream, 15 + 32) != Z_OK) // 15 + 32: gzip or zlib header
+                throw std::runtime_error("gzip: unable to initialize decompression");
+        }
+
+        ~GzipDecompressor() {
+            inflateEnd(&stream);
+        }
+
+        void decompress(const char* data, size_t size, const Output& output) override {
+            stream.next_in = reinterpret_cast<const Bytef*>(data);
+            stream.avail_in = size;
+            do {
+                if (ended) { // concatenated gzip members
+                    if (inflateReset(&stream) != Z_OK)
+                        throw std::runtime_error("gzip: corrupted data");
+                    ended = false;
+                }
+                stream.next_out = reinterpret_cast<Bytef*>(out.get());
+                stream.avail_out = outSize;
+                int ret = inflate(&stream, Z_NO_FLUSH);
+                size_t produced = outSize - stream.avail_out;
+                if (ret == Z_STREAM_END)
+                    ended = true;
+                else if (ret != Z_OK && (ret != Z_BUF_ERROR || produced == 0))
+                    throw std::runtime_error("gzip: corrupted data");
+                if (produced > 0)
+                    output(out.get(), produced);
+            } while (stream.avail_in > 0 || stream.avail_out == 0);
+        }
+
+        void finish(const Output&) override {
+            if (!ended)
+                throw std::runtime_error("gzip: unexpected end of file");
+        }
+    };
+#endif
+
+#ifdef XCSP3_HAVE_BZIP2
+    class Bzip2Decompressor : public XCSP3Decompressor {
+        bz_stream stream;
+        std::unique_ptr<char[]> out;
+        bool ended;
+
+        void init() {
+            std::memset(&stream, 0, sizeof(stream));
+            if (BZ2_bzDecompressInit(&stream, 0, 0) != BZ_OK)
+                throw std::runtime_error("bzip2: unable to initialize decompression");
+        }
+
+    public:
+        Bzip2Decompressor() : out(new char[outSize]), ended(false) {
+            init();
+        }
+
+        ~Bzip2Decompressor() {
+            BZ2_bzDecompressEnd(&stream);
+        }
+
+        void decompress(const char* data, size_t size, const Output& output) override {
+            char* in = const_cast<char*>(data); // bzlib does not write the input
+            unsigned int inSize = size;
+            do {
+                if (ended) { // concatenated bzip2 streams
+                    BZ2_bzDecompressEnd(&stream);
+                    init();
+                    ended = false;
+                }
+                stream.next_in = in;
+                stream.avail_in = inSize;
+                stream.next_out = out.get();
+                stream.avail_out = outSize;
+                int ret = BZ2_bzDecompress(&stream);
+                size_t produced = outSize - stream.avail_out;
+                in = stream.next_in;
+                inSize = stream.avail_in;
+                if (ret == BZ_STREAM_END)
+                    ended = true;
+                else if (ret != BZ_OK)
+                    throw std::runtime_error("bzip2: corrupted data");
+                if (produced > 0)
+                    output(out.get(), produced);
+            } while (inSize > 0 || stream.avail_out == 0);
+        }
+
+        void finish(const Output&) override {
+            if (!ended)
+                throw std::runtime_error("bzip2: unexpected end of file");
+        }
+    };
+#endif
+
+#ifdef XCSP3_HAVE_LZMA
+    class LzmaDecompressor : public XCSP3Decompressor {
+        lzma_stream stream;
+        std::unique_ptr<char[]> out;
+
+        void code(lzma_action action, const Output& output) {
+            lzma_ret ret;
+            do {
+                stream.next_out = reinterpret_cast<uint8_t*>(out.get());
+                stream.avail_out = outSize;
+                ret = lzma_code(&stream, action);
+                size_t produced = outSize - stream.avail_out;
+                if (ret != LZMA_OK && ret != LZMA_STREAM_END)
+                    throw std::runtime_error(ret == LZMA_BUF_ERROR ? "xz/lzma: unexpected end of file" : "xz/lzma: corrupted data");
+                if (produced > 0)
+                    output(out.get(), produced);
+            } while (ret != LZMA_STREAM_END && (stream.avail_in > 0 || stream.avail_out == 0 || action == LZMA_FINISH));
+        }
+
+    public:
+        explicit LzmaDecompressor(Format format) : stream(LZMA_STREAM_INIT), out(new char[outSize]) {
+            lzma_ret ret = format == Format::XZ ? lzma_stream_decoder(&stream, UINT64_MAX, LZMA_CONCATENATED)
+                                                : lzma_alone_decoder(&stream, UINT64_MAX);
+            if (ret != LZMA_OK)
+                throw std::runtime_error("xz/lzma: unable to initialize decompression");
+        }
+
+        ~LzmaDecompressor() {
+            lzma_end(&stream);
+        }
+
+        void decompress(const char* data, size_t size, const Output& output) override {
+            stream.next_in = reinterpret_cast<const uint8_t*>(data);
+            stream.avail_in = size;
+            code(LZMA_RUN, output);
+        }
+
+        void finish(const Output& output) override {
+            code(LZMA_FINISH, output);
+        }
+    };
+#endif
+} // namespace
+
+std::unique_ptr<XCSP3Decompressor> XCSP3Decompressor::create(Format format) {
+    switch (format) {
+    case Format::NONE:
+        return nullptr;
+    case Format::GZIP:
+#ifdef XCSP3_HAVE_ZLIB
+        return std::unique_ptr<XCSP3Decompressor>(new GzipDecompressor());
+#else
+        throw std::runtime_error("This parser was built without gzip support (zlib)");
+#endif
+    case Format::BZIP2:
+#ifdef XCSP3_HAVE_BZIP2
+        return std::unique_ptr<XCSP3Decompressor>(new Bzip2Decompressor());
+#else
+        throw std::runtime_error("This parser was built without bzip2 support (libbz2)");
+#endif
+    case Format::XZ:
+    case Format::LZMA:
+#ifdef XCSP3_HAVE_LZMA
+        return std::unique_ptr<XCSP3Decompressor>(new LzmaDecompressor(format));
+#else
+        throw std::runtime_error("This parser was built without xz/lzma support (liblzma)");
+#endif
+    }
+    return nullptr;
+}
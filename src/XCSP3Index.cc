@@ -0,0 +1,258 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XCSP3Index.h"
+#include "XCSP3utils.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using namespace XCSP3Core;
+
+namespace {
+    inline bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    inline bool isNameEnd(char c) {
+        return isSpace(c) || c == '>' || c == '/' || c == '=';
+    }
+
+    const char* find(const char* b, const char* e, const char* s, size_t length) {
+        return static_cast<const char*>(memmem(b, e - b, s, length));
+    }
+
+    [[noreturn]] void error(const char* message) {
+        throw std::runtime_error(std::string("XML error while indexing: ") + message);
+    }
+
+    /**
+     * Return the position after the comment, processing instruction, CDATA section
+     * or DOCTYPE starting at p
+     */
+    const char* skipMarkup(const char* p, const char* e) {
+        const char* q;
+        size_t length;
+        if (p[1] == '?') {
+            q = find(p + 2, e, "?>", 2);
+            length = 2;
+        } else if (e - p >= 4 && memcmp(p, "<!--", 4) == 0) {
+            q = find(p + 4, e, "-->", 3);
+            length = 3;
+        } else if (e - p >= 9 && memcmp(p, "<![CDATA[", 9) == 0) {
+            q = find(p + 9, e, "]]>", 3);
+            length = 3;
+        } else {
+            // DOCTYPE, possibly with an internal subset between brackets
+            q = static_cast<const char*>(memchr(p, '>', e - p));
+            const char* bracket = q != nullptr ? static_cast<const char*>(memchr(p, '[', q - p)) : nullptr;
+            if (bracket != nullptr) {
+                q = static_cast<const char*>(memchr(bracket, ']', e - bracket));
+                q = q != nullptr ? static_cast<const char*>(memchr(q, '>', e - q)) : nullptr;
+            }
+            length = 1;
+        }
+        if (q == nullptr)
+            error("unterminated markup");
+        return q + length;
+    }
+
+    // attribute value normalization: each white space becomes a space
+    std::string normalize(const char* b, const char* e) {
+        std::string s(b, e);
+        for (char& c : s)
+            if (isSpace(c))
+                c = ' ';
+        return s;
+    }
+} // namespace
+
+XCSP3Index XCSP3Index::build(const char* data, size_t size) {
+    XCSP3Index index;
+    index.size = size;
+
+    const char *p = data, *e = data + size;
+    std::vector<int> open; // the entry of each open element, -1 if it is not indexed
+
+    // only the markup is looked at: text (tuples...) is skipped by memchr
+    while ((p = static_cast<const char*>(memchr(p, '<', e - p))) != nullptr) {
+        if (p + 1 == e)
+            error("unexpected end of document");
+
+        if (p[1] == '!' || p[1] == '?') {
+            p = skipMarkup(p, e);
+            continue;
+        }
+
+        if (p[1] == '/') {
+            const char* gt = static_cast<const char*>(memchr(p, '>', e - p));
+            if (gt == nullptr)
+                error("unterminated end tag");
+            if (open.empty())
+                error("end tag without start tag");
+            if (open.back() >= 0) {
+                Entry& entry = index.entries[open.back()];
+                entry.contentEnd = p - data;
+                entry.end = gt + 1 - data;
+            }
+            open.pop_back();
+            p = gt + 1;
+            continue;
+        }
+
+        // start tag: the root, its children and the children of <constraints> are indexed
+        size_t level = open.size();
+        bool indexed = level == 0 || (level <= 2 && open.back() >= 0 && (level == 1 || index.entries[open.back()].tag == "constraints"));
+
+        const char* name = p + 1;
+        const char* q = name;
+        while (q < e && !isNameEnd(*q))
+            ++q;
+
+        Entry entry;
+        if (indexed) {
+            entry.level = static_cast<int>(level);
+            entry.tag.assign(name, q);
+            entry.begin = p - data;
+        }
+
+        // attributes are scanned (a value may contain '>'), id and class are kept
+        bool empty = false;
+        for (;;) {
+            while (q < e && isSpace(*q))
+                ++q;
+            if (q == e)
+                error("unterminated start tag");
+            if (*q == '>') {
+                ++q;
+                break;
+            }
+            if (*q == '/') {
+                if (q + 1 == e || q[1] != '>')
+                    error("invalid start tag");
+                q += 2;
+                empty = true;
+                break;
+            }
+            const char* attr = q;
+            while (q < e && !isNameEnd(*q))
+                ++q;
+            const char* attrEnd = q;
+            while (q < e && isSpace(*q))
+                ++q;
+            if (q == e || *q != '=')
+                error("attribute without value");
+            ++q;
+            while (q < e && isSpace(*q))
+                ++q;
+            if (q == e || (*q != '"' && *q != '\''))
+                error("attribute value must be quoted");
+            const char* value = q + 1;
+            q = static_cast<const char*>(memchr(value, *q, e - value));
+            if (q == nullptr)
+                error("unterminated attribute value");
+            if (indexed && attrEnd - attr == 2 && memcmp(attr, "id", 2) == 0)
+                entry.id = normalize(value, q);
+            if (indexed && attrEnd - attr == 5 && memcmp(attr, "class", 5) == 0)
+                entry.classes = normalize(value, q);
+            ++q;
+        }
+
+        if (indexed) {
+            entry.contentBegin = q - data;
+            entry.contentEnd = entry.end = empty ? entry.contentBegin : 0;
+            index.entries.push_back(entry);
+        }
+        if (!empty)
+            open.push_back(indexed ? static_cast<int>(index.entries.size()) - 1 : -1);
+        p = q;
+    }
+
+    if (!open.empty())
+        error("premature end of data: missing end tags");
+    return index;
+}
+
+void XCSP3Index::save(const std::string& filename) const {
+    std::ofstream out(filename);
+    if (!out)
+        throw std::runtime_error("Unable to create the index " + filename);
+
+    out << "XCSP3 index 1\n" << size << "\n";
+    for (const Entry& entry : entries)
+        out << entry.level << '\t' << entry.tag << '\t' << entry.begin << '\t' << entry.contentBegin << '\t' << entry.contentEnd << '\t'
+            << entry.end << '\t' << entry.id << '\t' << entry.classes << '\n';
+
+    if (!out)
+        throw std::runtime_error("Unable to write the index " + filename);
+}
+
+XCSP3Index XCSP3Index::load(const std::string& filename) {
+    std::ifstream in(filename);
+    if (!in)
+        throw std::runtime_error("Unable to open the index " + filename);
+
+    XCSP3Index index;
+    std::string line;
+    if (!std::getline(in, line) || line != "XCSP3 index 1" || !std::getline(in, line))
+        throw std::runtime_error("Not an index: " + filename);
+    index.size = std::stoull(line);
+
+    while (std::getline(in, line)) {
+        // the class is the last field: it is dropped by split when it is empty
+        std::vector<std::string> fields = split(line, '\t');
+        if (fields.size() != 7 && fields.size() != 8)
+            throw std::runtime_error("Malformed index entry: " + line);
+        Entry entry;
+        entry.level = toInt(fields[0]);
+        entry.tag = fields[1];
+        entry.begin = std::stoull(fields[2]);
+        entry.contentBegin = std::stoull(fields[3]);
+        entry.contentEnd = std::stoull(fields[4]);
+        entry.end = std::stoull(fields[5]);
+        entry.id = fields[6];
+        if (fields.size() == 8)
+            entry.classes = fields[7];
+        if (entry.end > index.size)
+            throw std::runtime_error("Malformed index entry: " + line);
+        index.entries.push_back(entry);
+    }
+    return index;
+}
+
+XCSP3Index::Filter XCSP3Index::withId(const std::string& id) {
+    return [id](const Entry& entry) { return entry.id == id; };
+}
+
+XCSP3Index::Filter XCSP3Index::withClass(const std::string& cls) {
+    return [cls](const Entry& entry) {
+        std::vector<std::string> classes = split(entry.classes, ' ');
+        return std::find(classes.begin(), classes.end(), cls) != classes.end();
+    };
+}
+
+XCSP3Index::Filter XCSP3Index::withTag(const std::string& tag) {
+    return [tag](const Entry& entry) { return entry.tag == tag; };
+}
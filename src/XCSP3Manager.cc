@@ -101,11 +101,11 @@ public:
         if (operators[0] == Expr::EQ || operators[0] == Expr::NE) {
             std::vector<int> values;
             values.push_back(constants[0]);
-            manager.callback->buildConstraintExtension(id, static_cast<XVariable*>(manager.mapping[variables[0]]), values, operators[0] == Expr::EQ, false);
+            manager.callback->buildConstraintExtension(id, static_cast<XVariable*>(manager.mapping.find(variables[0])), values, operators[0] == Expr::EQ, false);
             return true;
         }
         if (operators[0] == Expr::LE) {
-            manager.callback->buildConstraintPrimitive(id, OrderType::LE, static_cast<XVariable*>(manager.mapping[variables[0]]), constants[0]);
+            manager.callback->buildConstraintPrimitive(id, OrderType::LE, static_cast<XVariable*>(manager.mapping.find(variables[0])), constants[0]);
             return true;
         }
         return false;
@@ -117,7 +117,7 @@ public:
     PrimitiveUnary2(XCSP3Manager& m) : PrimitivePattern(m, "le(3,x)") {}
 
     bool post() override {
-        manager.callback->buildConstraintPrimitive(id, OrderType::GE, static_cast<XVariable*>(manager.mapping[variables[0]]), constants[0]);
+        manager.callback->buildConstraintPrimitive(id, OrderType::GE, static_cast<XVariable*>(manager.mapping.find(variables[0])), constants[0]);
         return true;
     }
 };
@@ -142,7 +142,7 @@ public:
                 manager.callback->buildConstraintTrue(id);
             return true;
         }
-        manager.callback->buildConstraintExtension(id, static_cast<XVariable*>(manager.mapping[variables[0]]), values, operators[0] == Expr::IN, false);
+        manager.callback->buildConstraintExtension(id, static_cast<XVariable*>(manager.mapping.find(variables[0])), values, operators[0] == Expr::IN, false);
         return true;
     }
 };
@@ -160,13 +160,13 @@ public:
             if (constants[1] > constants[0])
                 manager.callback->buildConstraintFalse(id);
             else
-                manager.callback->buildConstraintPrimitive(id, static_cast<XVariable*>(manager.mapping[variables[0]]), true, constants[1], constants[0]);
+                manager.callback->buildConstraintPrimitive(id, static_cast<XVariable*>(manager.mapping.find(variables[0])), true, constants[1], constants[0]);
             return true;
         }
         if (constants[0] > constants[1])
             manager.callback->buildConstraintTrue(id);
         else
-            manager.callback->buildConstraintPrimitive(id, static_cast<XVariable*>(manager.mapping[variables[0]]), false, constants[0] + 1, constants[1] - 1);
+            manager.callback->buildConstraintPrimitive(id, static_cast<XVariable*>(manager.mapping.find(variables[0])), false, constants[0] + 1, constants[1] - 1);
         return true;
     }
 };
@@ -180,8 +180,8 @@ public:
     bool post() override {
         if (operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping[variables[0]]), 0,
-                                                   static_cast<XVariable*>(manager.mapping[variables[1]]));
+        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping.find(variables[0])), 0,
+                                                   static_cast<XVariable*>(manager.mapping.find(variables[1])));
         return true;
     }
 };
@@ -195,8 +195,8 @@ public:
     bool post() override {
         if (operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping[variables[0]]), constants[0],
-                                                   static_cast<XVariable*>(manager.mapping[variables[1]]));
+        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping.find(variables[0])), constants[0],
+                                                   static_cast<XVariable*>(manager.mapping.find(variables[1])));
 
         return true;
     }
@@ -212,8 +212,8 @@ public:
         if (operators.size() != 1 || isRelationalOperator(operators[0]) == false)
             return false;
         constants[0] = -constants[0];
-        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping[variables[0]]), constants[0],
-                                                   static_cast<XVariable*>(manager.mapping[variables[1]]));
+        manager.callback->buildConstraintPrimitive(id, expressionTypeToOrderType(operators[0]), static_cast<XVariable*>(manager.mapping.find(variables[0])), constants[0],
+                                                   static_cast<XVariable*>(manager.mapping.find(variables[1])));
 
         return true;
     }
@@ -230,7 +230,7 @@ public:
             return false;
         std::vector<XVariable*> list;
         for (std::string& s : variables)
-            list.push_back(static_cast<XVariable*>(manager.mapping[s]));
+            list.push_back(static_cast<XVariable*>(manager.mapping.find(s)));
         std::vector<int> coefs;
         coefs.push_back(1);
         coefs.push_back(1);
@@ -250,9 +250,9 @@ public:
     PrimitiveTernary2(XCSP3Manager& m) : PrimitivePattern(m, "eq(mul(x,y),z)") {}
 
     bool post() override {
-        manager.callback->buildConstraintMult(id, static_cast<XVariable*>(manager.mapping[variables[0]]),
-                                              static_cast<XVariable*>(manager.mapping[variables[1]]),
-                                              static_cast<XVariable*>(manager.mapping[variables[2]]));
+        manager.callback->buildConstraintMult(id, static_cast<XVariable*>(manager.mapping.find(variables[0])),
+                                              static_cast<XVariable*>(manager.mapping.find(variables[1])),
+                                              static_cast<XVariable*>(manager.mapping.find(variables[2])));
         return true;
     }
 };
@@ -265,6 +265,8 @@ bool XCSP3Manager::recognizePrimitives(std::string id, Tree* tree) {
 }
 
 void XCSP3Manager::createPrimitivePatterns() {
+    // the trees of the patterns outlive the objects of a parse
+    DataPool::Scope scope(patternNodes);
     patterns.push_back(new PrimitiveUnary1(*this));
     patterns.push_back(new PrimitiveUnary2(*this));
     patterns.push_back(new PrimitiveUnary3(*this));
@@ -279,34 +281,44 @@ void XCSP3Manager::createPrimitivePatterns() {
 void XCSP3Manager::destroyPrimitivePatterns() {
     for (PrimitivePattern* p : patterns)
         delete p;
+    patterns.clear();
+    patternNodes.clear();
+}
+
+bool XCSP3Manager::toHandles(const std::vector<XVariable*>& list, std::vector<uint32_t>& result) {
+    if (!callback->useHandles)
+        return false;
+    result.clear();
+    for (XVariable* x : list) {
+        if (x == nullptr || x->handle == XVariable::NO_HANDLE)
+            return false;
+        result.push_back(x->handle);
+    }
+    return true;
 }
 
 void XCSP3Manager::buildVariable(XVariable* variable) {
     if (discardedClasses(variable->classes))
         return;
 
-    if (variable->domain->values.size() == 1) {
-        callback->buildVariableInteger(variable->id, variable->domain->values[0]->minimum(), variable->domain->values[0]->maximum());
-        return;
-    }
-    std::vector<int> values;
-
-    for (unsigned int i = 0; i < variable->domain->values.size(); i++) {
-        for (int j = variable->domain->values[i]->minimum();
-             j <= variable->domain->values[i]->maximum(); j++) {
-            values.push_back(j);
-        }
-    }
-    callback->buildVariableInteger(variable->id, values);
+    variable->handle = nbVariables++;
+    callback->buildVariableInteger(variable->id, *variable->domain);
 }
 
 void XCSP3Manager::buildVariableArray(XVariableArray* variable) {
     if (discardedClasses(variable->classes))
         return;
 
-    for (XVariable* v : variable->variables)
-        if (v != nullptr)
-            buildVariable(v);
+    // The cells are announced without being created: only those referenced later are
+    std::string id;
+    for (size_t i = 0; i < variable->size(); i++) {
+        XDomainInteger* domain = variable->domainAt(i);
+        if (domain == nullptr)
+            continue;
+        variable->setHandle(i, nbVariables++);
+        variable->cellId(i, id);
+        callback->buildVariableInteger(id, *domain);
+    }
 }
 
 //--------------------------------------------------------------------------------------
@@ -323,7 +335,10 @@ void XCSP3Manager::newConstraintExtension(XConstraintExtension* constraint) {
             tuples.push_back(tpl[0]);
         callback->buildConstraintExtension(constraint->id, constraint->list[0], tuples, constraint->isSupport,
                                            constraint->containsStar);
-    } else
+    } else if (toHandles(constraint->list, handles))
+        callback->buildConstraintExtension(constraint->id, XHandles(handles.data(), handles.size()), constraint->tuples,
+                                           constraint->isSupport, constraint->containsStar);
+    else
         callback->buildConstraintExtension(constraint->id, constraint->list, constraint->tuples,
                                            constraint->isSupport, constraint->containsStar);
 }
@@ -331,8 +346,12 @@ void XCSP3Manager::newConstraintExtension(XConstraintExtension* constraint) {
 void XCSP3Manager::newConstraintExtensionAsLastOne(XConstraintExtension* constraint) {
     if (discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintExtensionAs(constraint->id, constraint->list,
-                                         constraint->isSupport, constraint->containsStar);
+    if (constraint->list.size() > 1 && toHandles(constraint->list, handles))
+        callback->buildConstraintExtensionAs(constraint->id, XHandles(handles.data(), handles.size()),
+                                             constraint->isSupport, constraint->containsStar);
+    else
+        callback->buildConstraintExtensionAs(constraint->id, constraint->list,
+                                             constraint->isSupport, constraint->containsStar);
 }
 
 void XCSP3Manager::newConstraintIntension(XConstraintIntension* constraint) {
@@ -413,7 +432,10 @@ void XCSP3Manager::newConstraintAllDiff(XConstraintAllDiff* constraint) {
             callback->buildConstraintAlldifferent(constraint->id, trees);
             return;
         }
-        callback->buildConstraintAlldifferent(constraint->id, constraint->list);
+        if (toHandles(constraint->list, handles))
+            callback->buildConstraintAlldifferent(constraint->id, XHandles(handles.data(), handles.size()));
+        else
+            callback->buildConstraintAlldifferent(constraint->id, constraint->list);
     } else
         callback->buildConstraintAlldifferentExcept(constraint->id, constraint->list, constraint->except);
 }
@@ -433,7 +455,10 @@ void XCSP3Manager::newConstraintAllDiffList(XConstraintAllDiffList* constraint)
 void XCSP3Manager::newConstraintAllEqual(XConstraintAllEqual* constraint) {
     if (discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintAllEqual(constraint->id, constraint->list);
+    if (toHandles(constraint->list, handles))
+        callback->buildConstraintAllEqual(constraint->id, XHandles(handles.data(), handles.size()));
+    else
+        callback->buildConstraintAllEqual(constraint->id, constraint->list);
 }
 
 void XCSP3Manager::newConstraintOrdered(XConstraintOrdered* constraint) {
@@ -444,7 +469,9 @@ void XCSP3Manager::newConstraintOrdered(XConstraintOrdered* constraint) {
         for (XVariable* x : constraint->lengths)
             lengths.push_back((static_cast<XInteger*>(x))->value);
         callback->buildConstraintOrdered(constraint->id, constraint->list, lengths, constraint->op);
-    } else
+    } else if (toHandles(constraint->list, handles))
+        callback->buildConstraintOrdered(constraint->id, XHandles(handles.data(), handles.size()), constraint->op);
+    else
         callback->buildConstraintOrdered(constraint->id, constraint->list, constraint->op);
 }
 
@@ -527,7 +554,10 @@ void XCSP3Manager::newConstraintSum(XConstraintSum* constraint) {
                 constraint->values.assign(constraint->list.size(), new XInteger("", 1));
         }
         if (!toModify) {
-            callback->buildConstraintSum(constraint->id, constraint->list, xc);
+            if (toHandles(constraint->list, handles))
+                callback->buildConstraintSum(constraint->id, XHandles(handles.data(), handles.size()), xc);
+            else
+                callback->buildConstraintSum(constraint->id, constraint->list, xc);
             return;
         }
     }
@@ -545,13 +575,16 @@ void XCSP3Manager::newConstraintSum(XConstraintSum* constraint) {
         if (callback->normalizeSum)
             normalizeSum(list, coefs);
 
-        callback->buildConstraintSum(constraint->id, list, coefs, xc);
+        if (toHandles(list, handles))
+            callback->buildConstraintSum(constraint->id, XHandles(handles.data(), handles.size()), coefs, xc);
+        else
+            callback->buildConstraintSum(constraint->id, list, coefs, xc);
         return;
     }
 
     std::vector<XVariable*> xvalues;
     for (XEntity* xe : constraint->values) {
-        xvalues.push_back(static_cast<XVariable*>(mapping[xe->id]));
+        xvalues.push_back(static_cast<XVariable*>(mapping.find(xe->id)));
     }
     callback->buildConstraintSum(constraint->id, constraint->list, xvalues, xc);
 }
@@ -588,7 +621,7 @@ void XCSP3Manager::newConstraintCount(XConstraintCount* constraint) {
             return;
         }
         if (xc.operandType == OperandType::VARIABLE && xc.op == OrderType::EQ) {
-            callback->buildConstraintExactlyVariable(constraint->id, constraint->list, value, static_cast<XVariable*>(mapping[xc.var]));
+            callback->buildConstraintExactlyVariable(constraint->id, constraint->list, value, static_cast<XVariable*>(mapping.find(xc.var)));
             return;
         }
     }
@@ -614,7 +647,7 @@ void XCSP3Manager::newConstraintCount(XConstraintCount* constraint) {
     } else {
         std::vector<XVariable*> values;
         for (XEntity* xe : constraint->values) {
-            values.push_back(static_cast<XVariable*>(mapping[xe->id]));
+            values.push_back(static_cast<XVariable*>(mapping.find(xe->id)));
         }
         callback->buildConstraintCount(constraint->id, constraint->list, values, xc);
     }
@@ -965,7 +998,10 @@ void XCSP3Manager::newConstraintCumulative(XConstraintCumulative* constraint) {
 void XCSP3Manager::newConstraintInstantiation(XConstraintInstantiation* constraint) {
     if (discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintInstantiation(constraint->id, constraint->list, constraint->values);
+    if (toHandles(constraint->list, handles))
+        callback->buildConstraintInstantiation(constraint->id, XHandles(handles.data(), handles.size()), constraint->values);
+    else
+        callback->buildConstraintInstantiation(constraint->id, constraint->list, constraint->values);
 }
 
 //--------------------------------------------------------------------------------------
@@ -975,7 +1011,10 @@ void XCSP3Manager::newConstraintInstantiation(XConstraintInstantiation* constrai
 void XCSP3Manager::newConstraintClause(XConstraintClause* constraint) {
     if (discardedClasses(constraint->classes))
         return;
-    callback->buildConstraintClause(constraint->id, constraint->positive, constraint->negative);
+    if (toHandles(constraint->positive, handles) && toHandles(constraint->negative, others))
+        callback->buildConstraintClause(constraint->id, XHandles(handles.data(), handles.size()), XHandles(others.data(), others.size()));
+    else
+        callback->buildConstraintClause(constraint->id, constraint->positive, constraint->negative);
 }
 
 //--------------------------------------------------------------------------------------
@@ -1027,7 +1066,7 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup* group) {
                 // Check previous arguments
                 bool same = true;
                 for (unsigned int j = 0; j < previousArguments.size(); j++)
-                    if (previousArguments[j]->domain->equals(ce->list[j]->domain) == false) {
+                    if (previousArguments[j]->domain != ce->list[j]->domain) { // the domains are interned
                         same = false;
                         break;
                     }
@@ -1100,7 +1139,7 @@ void XCSP3Manager::newConstraintGroup(XConstraintGroup* group) {
 
 void XCSP3Manager::addObjective(XObjective* objective) {
     if (objective->type == ExpressionObjective::EXPRESSION_O) {
-        XVariable* x = static_cast<XVariable*>(mapping[objective->expression]);
+        XVariable* x = static_cast<XVariable*>(mapping.find(objective->expression));
         if (x != NULL) {
             if (objective->goal == ObjectiveGoal::MINIMIZE)
                 callback->buildObjectiveMinimizeVariable(x);
@@ -1150,6 +1189,20 @@ void XCSP3Manager::addObjective(XObjective* objective) {
             normalizeSum(objective->list, objective->coeffs);
     }
 
+    if (toHandles(objective->list, handles)) {
+        XHandles list(handles.data(), handles.size());
+        if (objective->coeffs.size() == 0) {
+            if (objective->goal == ObjectiveGoal::MINIMIZE)
+                callback->buildObjectiveMinimize(objective->type, list);
+            else
+                callback->buildObjectiveMaximize(objective->type, list);
+        } else if (objective->goal == ObjectiveGoal::MINIMIZE)
+            callback->buildObjectiveMinimize(objective->type, list, objective->coeffs);
+        else
+            callback->buildObjectiveMaximize(objective->type, list, objective->coeffs);
+        return;
+    }
+
     if (objective->coeffs.size() == 0) {
         if (objective->goal == ObjectiveGoal::MINIMIZE)
             callback->buildObjectiveMinimize(objective->type, objective->list);
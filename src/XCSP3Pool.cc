@@ -3,22 +3,223 @@
 #include "XCSP3Objective.h"
 #include "XCSP3Variable.h"
 #include "XCSP3Constraint.h"
-#include "XCSP3TreeNode.h" 
+#include "XCSP3TreeNode.h"
+#include <algorithm>
+#include <cstring>
+#include <sys/mman.h>
 
 namespace XCSP3Core {
-    Pool<XEntity> DataPool::EntityPool;
-    Pool<XIntegerEntity> DataPool::IntegerEntityPool;
-    Pool<XDomain> DataPool::DomainPool;
-    Pool<XConstraint> DataPool::ConstraintPool;
-    Pool<XObjective> DataPool::ObjectivePool;
-    Pool<Node> DataPool::NodePool;
+    static const size_t firstSlabSize = 64 * 1024;
+    static const size_t maxSlabSize = 4 * 1024 * 1024;
+    static const size_t hugePageSize = 2 * 1024 * 1024;
+
+    void* Arena::grow(size_t size, size_t alignment) {
+        size_t needed = size + alignment;
+        // a rewound arena fills its slabs again before allocating new ones
+        while (current + 1 < slabs.size()) {
+            current++;
+            next = slabs[current].memory;
+            end = next + slabs[current].size;
+            if (slabs[current].size >= needed)
+                return allocate(size, alignment);
+        }
+
+        size_t slabSize = slabs.empty() ? firstSlabSize : std::min(2 * slabs.back().size, maxSlabSize);
+        slabSize = std::max(slabSize, needed);
+        Slab slab{nullptr, slabSize, false};
+        if (hugePages) {
+            slab.size = (std::max(slabSize, hugePageSize) + hugePageSize - 1) / hugePageSize * hugePageSize;
+            void* memory = mmap(nullptr, slab.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory != MAP_FAILED) {
+#ifdef MADV_HUGEPAGE
+                madvise(memory, slab.size, MADV_HUGEPAGE);
+#endif
+                slab.memory = static_cast<char*>(memory);
+                slab.mapped = true;
+            } else
+                slab.size = slabSize;
+        }
+        if (slab.memory == nullptr)
+            slab.memory = new char[slab.size];
+        slabs.push_back(slab);
+        current = slabs.size() - 1;
+        next = slab.memory;
+        end = next + slab.size;
+        return allocate(size, alignment);
+    }
+
+    void Arena::rewind() {
+        current = 0;
+        next = slabs.empty() ? nullptr : slabs[0].memory;
+        end = slabs.empty() ? nullptr : next + slabs[0].size;
+    }
+
+    void Arena::release() {
+        for (Slab& slab : slabs) {
+            if (slab.mapped)
+                munmap(slab.memory, slab.size);
+            else
+                delete[] slab.memory;
+        }
+        std::vector<Slab>().swap(slabs);
+        rewind();
+    }
+
+    void Arena::abandon() {
+        std::vector<Slab>().swap(slabs);
+        rewind();
+    }
+
+    void Arena::swap(Arena& other) {
+        std::swap(slabs, other.slabs);
+        std::swap(current, other.current);
+        std::swap(next, other.next);
+        std::swap(end, other.end);
+        std::swap(hugePages, other.hugePages);
+    }
+
+    thread_local DataPool* DataPool::current_ = nullptr;
+
+    DataPool::DataPool() : sharedCells(false) {}
+
+    DataPool::~DataPool() {}
+
+    DataPool& DataPool::threadPool() {
+        static thread_local DataPool pool;
+        return pool;
+    }
 
     void DataPool::clear() {
-        Pool<XEntity>().swap(EntityPool);
-        Pool<XIntegerEntity>().swap(IntegerEntityPool);
-        Pool<XDomain>().swap(DomainPool);
-        Pool<XConstraint>().swap(ConstraintPool);
-        Pool<XObjective>().swap(ObjectivePool);
-        Pool<Node>().swap(NodePool);
-    }
-}
\ No newline at end of file
+        EntityPool.clear();
+        IntegerEntityPool.clear();
+        DomainPool.clear();
+        ConstraintPool.clear();
+        ObjectivePool.clear();
+        NodePool.clear();
+        symbols.clear();
+        CellPool.clear();
+        cellSymbols.clear();
+    }
+
+    void DataPool::reset() {
+        EntityPool.reset();
+        IntegerEntityPool.reset();
+        DomainPool.reset();
+        ConstraintPool.reset();
+        ObjectivePool.reset();
+        NodePool.reset();
+        symbols.reset();
+        CellPool.reset();
+        cellSymbols.reset();
+    }
+
+    void DataPool::leak() {
+        EntityPool.leak();
+        IntegerEntityPool.leak();
+        DomainPool.leak();
+        ConstraintPool.leak();
+        ObjectivePool.leak();
+        NodePool.leak();
+        symbols.leak();
+        CellPool.leak();
+        cellSymbols.leak();
+    }
+
+    void DataPool::useHugePages(bool hugePages) {
+        EntityPool.useHugePages(hugePages);
+        IntegerEntityPool.useHugePages(hugePages);
+        DomainPool.useHugePages(hugePages);
+        ConstraintPool.useHugePages(hugePages);
+        ObjectivePool.useHugePages(hugePages);
+        NodePool.useHugePages(hugePages);
+        symbols.useHugePages(hugePages);
+        CellPool.useHugePages(hugePages);
+        cellSymbols.useHugePages(hugePages);
+    }
+
+    void DataPool::swap(DataPool& other) {
+        EntityPool.swap(other.EntityPool);
+        IntegerEntityPool.swap(other.IntegerEntityPool);
+        DomainPool.swap(other.DomainPool);
+        ConstraintPool.swap(other.ConstraintPool);
+        ObjectivePool.swap(other.ObjectivePool);
+        NodePool.swap(other.NodePool);
+        symbols.swap(other.symbols);
+        CellPool.swap(other.CellPool);
+        cellSymbols.swap(other.cellSymbols);
+    }
+
+    const char* Symbol::emptyName() {
+        static const struct {
+            Header header;
+            char name[1];
+        } empty = {{hash(nullptr, 0), 0}, {0}};
+        return empty.name;
+    }
+
+    Symbol::Symbol(const std::string& s) : name(DataPool::current().symbols.intern(s).name) {}
+
+    Symbol::Symbol(const char* s) : name(DataPool::current().symbols.intern(s, strlen(s)).name) {}
+
+    Symbol SymbolTable::intern(const char* name, size_t size) {
+        if (4 * (count + 1) > 3 * slots.size())
+            rehash();
+        uint32_t hash = Symbol::hash(name, size);
+        size_t mask = slots.size() - 1;
+        size_t i = hash & mask;
+        for (; slots[i] != nullptr; i = (i + 1) & mask) {
+            Symbol symbol = Symbol::at(slots[i]);
+            if (symbol.hash() == hash && symbol.equals(name, size))
+                return symbol;
+        }
+
+        char* memory = static_cast<char*>(names.allocate(sizeof(Symbol::Header) + size + 1, alignof(Symbol::Header)));
+        Symbol::Header header = {hash, static_cast<uint32_t>(size)};
+        memcpy(memory, &header, sizeof(header));
+        char* interned = memory + sizeof(Symbol::Header);
+        memcpy(interned, name, size);
+        interned[size] = 0;
+        slots[i] = interned;
+        count++;
+        return Symbol::at(interned);
+    }
+
+    void SymbolTable::rehash() {
+        std::vector<const char*> old(std::max(static_cast<size_t>(1024), 2 * slots.size()), nullptr);
+        old.swap(slots);
+        size_t mask = slots.size() - 1;
+        for (const char* name : old) {
+            if (name == nullptr)
+                continue;
+            size_t i = Symbol::at(name).hash() & mask;
+            while (slots[i] != nullptr)
+                i = (i + 1) & mask;
+            slots[i] = name;
+        }
+    }
+
+    void SymbolTable::clear() {
+        std::vector<const char*>().swap(slots);
+        count = 0;
+        names.release();
+    }
+
+    void SymbolTable::reset() {
+        std::fill(slots.begin(), slots.end(), nullptr);
+        count = 0;
+        names.rewind();
+    }
+
+    void SymbolTable::leak() {
+        new std::vector<const char*>(std::move(slots)); // never deleted: nothing to free at the end
+        slots.clear();
+        count = 0;
+        names.abandon();
+    }
+
+    void SymbolTable::swap(SymbolTable& other) {
+        names.swap(other.names);
+        slots.swap(other.slots);
+        std::swap(count, other.count);
+    }
+}
@@ -26,6 +26,7 @@
 #include "XCSP3Tree.h"
 #include "XCSP3TreeNode.h"
 #include "XCSP3Pool.h"
+#include "XCSP3utils.h"
 #include <algorithm>
 #include <limits>
 #include <map>
@@ -34,26 +35,6 @@
 
 using namespace XCSP3Core;
 
-// trim from start
-
-static inline std::string& ltrim(std::string& s) {
-    s.erase(s.begin(), std::find_if(s.begin(), s.end(), std::not1(std::ptr_fun<int, int>(std::isspace))));
-    return s;
-}
-
-// trim from end
-
-static inline std::string& rtrim(std::string& s) {
-    s.erase(std::find_if(s.rbegin(), s.rend(), std::not1(std::ptr_fun<int, int>(std::isspace))).base(), s.end());
-    return s;
-}
-
-// trim from both ends
-
-static inline std::string& trim(std::string& s) {
-    return ltrim(rtrim(s));
-}
-
 template <typename T>
 static int min(T v1, T v2, T v3) {
     if (v1 == -1)
@@ -130,8 +111,8 @@ void Tree::closeOperator(std::vector<NodeOperator*>& stack, std::vector<Node*>&
 // string currentElement, std::vector<NodeOperator*> &stack,std::vector<Node*> &params
 void Tree::createBasicParameter(std::string currentElement, std::vector<NodeOperator*>&, std::vector<Node*>& params) {
     try {
-        int nb = std::stoi(currentElement);
-        params.push_back(DataPool::NodePool.make<NodeConstant>(nb));
+        int nb = toInt(currentElement);
+        params.push_back(DataPool::current().NodePool.make<NodeConstant>(nb));
     } catch (std::invalid_argument const&) {
         int position = -1;
         for (unsigned int i = 0; i < listOfVariables.size(); i++)
@@ -143,6 +124,6 @@ void Tree::createBasicParameter(std::string currentElement, std::vector<NodeOper
             listOfVariables.push_back(currentElement);
             position = listOfVariables.size() - 1;
         }
-        params.push_back(DataPool::NodePool.make<NodeVariable>(currentElement));
+        params.push_back(DataPool::current().NodePool.make<NodeVariable>(currentElement));
     }
 }
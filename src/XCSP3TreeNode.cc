@@ -132,41 +132,41 @@ Expr XCSP3Core::stringToOperator(const std::string& op) {
 
 NodeOperator* createNodeOperator(Expr op) {
     NodeOperator* tmp = nullptr;
-    if (op == Expr::NEG) tmp = DataPool::NodePool.make<NodeNeg>();
-    if (op == Expr::ABS) tmp = DataPool::NodePool.make<NodeAbs>();
-
-    if (op == Expr::ADD) tmp = DataPool::NodePool.make<NodeAdd>();
-    if (op == Expr::SUB) tmp = DataPool::NodePool.make<NodeSub>();
-    if (op == Expr::MUL) tmp = DataPool::NodePool.make<NodeMult>();
-    if (op == Expr::DIV) tmp = DataPool::NodePool.make<NodeDiv>();
-    if (op == Expr::MOD) tmp = DataPool::NodePool.make<NodeMod>();
-
-    if (op == Expr::SQR) tmp = DataPool::NodePool.make<NodeSquare>();
-    if (op == Expr::POW) tmp = DataPool::NodePool.make<NodePow>();
-
-    if (op == Expr::MIN) tmp = DataPool::NodePool.make<NodeMin>();
-    if (op == Expr::MAX) tmp = DataPool::NodePool.make<NodeMax>();
-    if (op == Expr::DIST) tmp = DataPool::NodePool.make<NodeDist>();
-
-    if (op == Expr::LE) tmp = DataPool::NodePool.make<NodeLE>();
-    if (op == Expr::LT) tmp = DataPool::NodePool.make<NodeLT>();
-    if (op == Expr::GE) tmp = DataPool::NodePool.make<NodeGE>();
-    if (op == Expr::GT) tmp = DataPool::NodePool.make<NodeGT>();
-
-    if (op == Expr::NE) tmp = DataPool::NodePool.make<NodeNE>();
-    if (op == Expr::EQ) tmp = DataPool::NodePool.make<NodeEQ>();
-
-    if (op == Expr::NOT) tmp = DataPool::NodePool.make<NodeNot>();
-    if (op == Expr::AND) tmp = DataPool::NodePool.make<NodeAnd>();
-    if (op == Expr::OR) tmp = DataPool::NodePool.make<NodeOr>();
-    if (op == Expr::XOR) tmp = DataPool::NodePool.make<NodeXor>();
-    if (op == Expr::IMP) tmp = DataPool::NodePool.make<NodeImp>();
-    if (op == Expr::IF) tmp = DataPool::NodePool.make<NodeIf>();
-    if (op == Expr::IFF) tmp = DataPool::NodePool.make<NodeIff>();
-
-    if (op == Expr::IN) tmp = DataPool::NodePool.make<NodeIn>();
-    if (op == Expr::NOTIN) tmp = DataPool::NodePool.make<NodeNotIn>();
-    if (op == Expr::SET) tmp = DataPool::NodePool.make<NodeSet>();
+    if (op == Expr::NEG) tmp = DataPool::current().NodePool.make<NodeNeg>();
+    if (op == Expr::ABS) tmp = DataPool::current().NodePool.make<NodeAbs>();
+
+    if (op == Expr::ADD) tmp = DataPool::current().NodePool.make<NodeAdd>();
+    if (op == Expr::SUB) tmp = DataPool::current().NodePool.make<NodeSub>();
+    if (op == Expr::MUL) tmp = DataPool::current().NodePool.make<NodeMult>();
+    if (op == Expr::DIV) tmp = DataPool::current().NodePool.make<NodeDiv>();
+    if (op == Expr::MOD) tmp = DataPool::current().NodePool.make<NodeMod>();
+
+    if (op == Expr::SQR) tmp = DataPool::current().NodePool.make<NodeSquare>();
+    if (op == Expr::POW) tmp = DataPool::current().NodePool.make<NodePow>();
+
+    if (op == Expr::MIN) tmp = DataPool::current().NodePool.make<NodeMin>();
+    if (op == Expr::MAX) tmp = DataPool::current().NodePool.make<NodeMax>();
+    if (op == Expr::DIST) tmp = DataPool::current().NodePool.make<NodeDist>();
+
+    if (op == Expr::LE) tmp = DataPool::current().NodePool.make<NodeLE>();
+    if (op == Expr::LT) tmp = DataPool::current().NodePool.make<NodeLT>();
+    if (op == Expr::GE) tmp = DataPool::current().NodePool.make<NodeGE>();
+    if (op == Expr::GT) tmp = DataPool::current().NodePool.make<NodeGT>();
+
+    if (op == Expr::NE) tmp = DataPool::current().NodePool.make<NodeNE>();
+    if (op == Expr::EQ) tmp = DataPool::current().NodePool.make<NodeEQ>();
+
+    if (op == Expr::NOT) tmp = DataPool::current().NodePool.make<NodeNot>();
+    if (op == Expr::AND) tmp = DataPool::current().NodePool.make<NodeAnd>();
+    if (op == Expr::OR) tmp = DataPool::current().NodePool.make<NodeOr>();
+    if (op == Expr::XOR) tmp = DataPool::current().NodePool.make<NodeXor>();
+    if (op == Expr::IMP) tmp = DataPool::current().NodePool.make<NodeImp>();
+    if (op == Expr::IF) tmp = DataPool::current().NodePool.make<NodeIf>();
+    if (op == Expr::IFF) tmp = DataPool::current().NodePool.make<NodeIff>();
+
+    if (op == Expr::IN) tmp = DataPool::current().NodePool.make<NodeIn>();
+    if (op == Expr::NOTIN) tmp = DataPool::current().NodePool.make<NodeNotIn>();
+    if (op == Expr::SET) tmp = DataPool::current().NodePool.make<NodeSet>();
 
     assert(tmp != nullptr);
 
@@ -276,17 +276,17 @@ Node* NodeOperator::canonize() {
     if (newType == Expr::LT && newParams[1]->type == Expr::DECIMAL) { // lt(x,k) becomes le(x,k-1)
         NodeConstant* c = dynamic_cast<NodeConstant*>(newParams[1]);
         c->val = c->val - 1;
-        return DataPool::NodePool.make<NodeLE>()->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
+        return DataPool::current().NodePool.make<NodeLE>()->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
     }
     if (newType == Expr::LT && newParams[0]->type == Expr::DECIMAL) { // lt(k,x) becomes le(k+1,x)
         NodeConstant* c = dynamic_cast<NodeConstant*>(newParams[0]);
         c->val = c->val + 1;
-        return DataPool::NodePool.make<NodeLE>()->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
+        return DataPool::current().NodePool.make<NodeLE>()->addParameter(newParams[0])->addParameter(newParams[1])->canonize();
     }
 
     NodeOperator* tmp = dynamic_cast<NodeOperator*>(newParams[0]); // abs(sub becomes dist
     if (newType == Expr::ABS && newParams[0]->type == Expr::SUB)
-        return DataPool::NodePool.make<NodeDist>()->addParameters(tmp->parameters)->canonize();
+        return DataPool::current().NodePool.make<NodeDist>()->addParameters(tmp->parameters)->canonize();
 
     if (newType == Expr::NOT && newParams[0]->type == Expr::NOT) // NOT(NOT.. becomes ..
         return tmp->parameters[0]->canonize();
@@ -307,12 +307,12 @@ Node* NodeOperator::canonize() {
             (c2 = dynamic_cast<NodeConstant*>(newParams[newParams.size() - 2])) != nullptr) {
             std::vector<Node*> l;
             l.insert(l.end(), newParams.begin(), newParams.end() - 2);
-            l.push_back(newType == Expr::ADD ? DataPool::NodePool.make<NodeConstant>(c1->val + c2->val) : DataPool::NodePool.make<NodeConstant>(c1->val * c2->val));
+            l.push_back(newType == Expr::ADD ? DataPool::current().NodePool.make<NodeConstant>(c1->val + c2->val) : DataPool::current().NodePool.make<NodeConstant>(c1->val * c2->val));
 
             if (newType == Expr::ADD)
-                return DataPool::NodePool.make<NodeAdd>()->addParameters(l)->canonize();
+                return DataPool::current().NodePool.make<NodeAdd>()->addParameters(l)->canonize();
             else
-                return DataPool::NodePool.make<NodeMult>()->addParameters(l)->canonize();
+                return DataPool::current().NodePool.make<NodeMult>()->addParameters(l)->canonize();
         }
     }
 
@@ -320,8 +320,8 @@ Node* NodeOperator::canonize() {
     if (pattern(this, "le(add(y[4],5),7)", operators, constants, variables, true)) {
         if (newType == Expr::EQ || newType == Expr::NE || newType == Expr::LE || newType == Expr::LT)
             return createNodeOperator(newType)
-                ->addParameter(DataPool::NodePool.make<NodeVariable>(variables[0]))
-                ->addParameter(DataPool::NodePool.make<NodeConstant>(constants[1] - constants[0]))
+                ->addParameter(DataPool::current().NodePool.make<NodeVariable>(variables[0]))
+                ->addParameter(DataPool::current().NodePool.make<NodeConstant>(constants[1] - constants[0]))
                 ->canonize();
     }
 
@@ -329,8 +329,8 @@ Node* NodeOperator::canonize() {
     if (pattern(this, "le(8,add(y[4],5))", operators, constants, variables, true)) {
         if (newType == Expr::EQ || newType == Expr::NE || newType == Expr::LE || newType == Expr::LT)
             return createNodeOperator(newType)
-                ->addParameter(DataPool::NodePool.make<NodeConstant>(constants[0] - constants[1]))
-                ->addParameter(DataPool::NodePool.make<NodeVariable>(variables[0]))
+                ->addParameter(DataPool::current().NodePool.make<NodeConstant>(constants[0] - constants[1]))
+                ->addParameter(DataPool::current().NodePool.make<NodeVariable>(variables[0]))
                 ->canonize();
     }
 
@@ -338,8 +338,8 @@ Node* NodeOperator::canonize() {
     if (pattern(this, "le(8,add(5,y[4]))", operators, constants, variables, true)) {
         if (newType == Expr::EQ || newType == Expr::NE || newType == Expr::LE || newType == Expr::LT)
             return createNodeOperator(newType)
-                ->addParameter(DataPool::NodePool.make<NodeConstant>(constants[0] - constants[1]))
-                ->addParameter(DataPool::NodePool.make<NodeVariable>(variables[0]))
+                ->addParameter(DataPool::current().NodePool.make<NodeConstant>(constants[0] - constants[1]))
+                ->addParameter(DataPool::current().NodePool.make<NodeVariable>(variables[0]))
                 ->canonize();
     }
 
@@ -347,16 +347,16 @@ Node* NodeOperator::canonize() {
     if (pattern(this, "eq(mul(y[0],3),9)", operators, constants, variables) ||
         pattern(this, "eq(mul(3,x),6)", operators, constants, variables)) {
         if (constants[1] % constants[0] != 0)
-            return DataPool::NodePool.make<NodeConstant>(0);
-        return DataPool::NodePool.make<NodeEQ>()->addParameter(DataPool::NodePool.make<NodeVariable>(variables[0]))->addParameter(DataPool::NodePool.make<NodeConstant>(constants[1] / constants[0]))->canonize();
+            return DataPool::current().NodePool.make<NodeConstant>(0);
+        return DataPool::current().NodePool.make<NodeEQ>()->addParameter(DataPool::current().NodePool.make<NodeVariable>(variables[0]))->addParameter(DataPool::current().NodePool.make<NodeConstant>(constants[1] / constants[0]))->canonize();
     }
 
     //eq(9,mul(3,y[0]))
     if (pattern(this, "eq(9,mul(3,y[0]))", operators, constants, variables) ||
         pattern(this, "eq(9,mul(y[0],3))", operators, constants, variables)) {
         if (constants[0] % constants[1] != 0)
-            return DataPool::NodePool.make<NodeConstant>(0);
-        return DataPool::NodePool.make<NodeEQ>()->addParameter(DataPool::NodePool.make<NodeVariable>(variables[0]))->addParameter(DataPool::NodePool.make<NodeConstant>(constants[0] / constants[1]))->canonize();
+            return DataPool::current().NodePool.make<NodeConstant>(0);
+        return DataPool::current().NodePool.make<NodeEQ>()->addParameter(DataPool::current().NodePool.make<NodeVariable>(variables[0]))->addParameter(DataPool::current().NodePool.make<NodeConstant>(constants[0] / constants[1]))->canonize();
     }
 
     // Then, we merge operators when possible; for example add(add(x,y),z) becomes add(x,y,z)
@@ -381,16 +381,16 @@ Node* NodeOperator::canonize() {
         NodeOperator* n1 = dynamic_cast<NodeOperator*>(newParams[1]);
         // First, we replace sub by add when possible
         if (newParams[0]->type == Expr::SUB && newParams[1]->type == Expr::SUB) {
-            Node* a = DataPool::NodePool.make<NodeAdd>()->addParameter(n0->parameters[0])->addParameter(n1->parameters[1]);
-            Node* b = DataPool::NodePool.make<NodeAdd>()->addParameter(n1->parameters[0])->addParameter(n0->parameters[1]);
+            Node* a = DataPool::current().NodePool.make<NodeAdd>()->addParameter(n0->parameters[0])->addParameter(n1->parameters[1]);
+            Node* b = DataPool::current().NodePool.make<NodeAdd>()->addParameter(n1->parameters[0])->addParameter(n0->parameters[1]);
             return (createNodeOperator(newType))->addParameter(a)->addParameter(b)->canonize();
         } else if (newParams[1]->type == Expr::SUB) {
-            Node* a = DataPool::NodePool.make<NodeAdd>()->addParameter(newParams[0])->addParameter(n1->parameters[1]);
+            Node* a = DataPool::current().NodePool.make<NodeAdd>()->addParameter(newParams[0])->addParameter(n1->parameters[1]);
             Node* b = n1->parameters[0];
             return (createNodeOperator(newType))->addParameter(a)->addParameter(b)->canonize();
         } else if (n0 != nullptr && n0->op == "sub") {
             Node* a = n0->parameters[0];
-            Node* b = DataPool::NodePool.make<NodeAdd>()->addParameter(newParams[1])->addParameter(n0->parameters[1]);
+            Node* b = DataPool::current().NodePool.make<NodeAdd>()->addParameter(newParams[1])->addParameter(n0->parameters[1]);
             return (createNodeOperator(newType))->addParameter(a)->addParameter(b)->canonize();
         }
 
@@ -399,7 +399,7 @@ Node* NodeOperator::canonize() {
             if (n0->parameters.size() == 2 && n0->parameters[0]->type == Expr::VAR && n0->parameters[1]->type == Expr::DECIMAL) {
                 NodeConstant* c1 = dynamic_cast<NodeConstant*>(newParams[1]);
                 NodeConstant* c2 = dynamic_cast<NodeConstant*>(n0->parameters[1]);
-                return (createNodeOperator(newType))->addParameter(n0->parameters[0])->addParameter(DataPool::NodePool.make<NodeConstant>(c1->val - c2->val))->canonize();
+                return (createNodeOperator(newType))->addParameter(n0->parameters[0])->addParameter(DataPool::current().NodePool.make<NodeConstant>(c1->val - c2->val))->canonize();
             }
         }
 
@@ -27,6 +27,10 @@
 #include "XCSP3Constraint.h"
 #include "XCSP3Domain.h"
 #include "XCSP3Variable.h"
+#include <algorithm>
+#include <exception>
+#include <iterator>
+#include <thread>
 
 using namespace XCSP3Core;
 
@@ -34,134 +38,146 @@ using namespace XCSP3Core;
 //    callbacks from the XML parser
 //------------------------------------------------------------------------------------------
 
-void XMLParser::startElement(UTF8String name, const AttributeList& attributes) {
-    // consume the last tokens before we switch to the next element
-    if (!textLeft.empty()) {
-        handleAbridgedNotation(textLeft, true);
-        textLeft.clear();
-    }
+XMLParser::TagAction* XMLParser::getTagAction(UTF8String name) {
+    TagAction* action = tagActions[static_cast<int>(tagType(name.begin().getPointer(), name.byteLength()))].get();
+
+    if (action != nullptr)
+        return action;
+
+    // ???
+    //if (!action->isActivated())
+    //  throw runtime_error("unexpected tag");
 
-    if (!stateStack.empty() && !stateStack.front().subtagAllowed)
-        throw std::runtime_error("this element must not contain any element");
+    // add a handler to ignore the text and end element
+    std::cerr << "unknown tag " << name << std::endl;
+    return unknownTagHandler.get();
+}
 
-    TagActionList::iterator iAction = tagList.find(name);
-    TagAction* action;
+void XMLParser::startElement(UTF8String name, const AttributeList& attributes) {
+    startElement(getTagAction(name), attributes);
+}
 
-    if (iAction != tagList.end()) {
-        action = (*iAction).second.get();
+void XMLParser::startElement(const UTF8String::Byte* internedName, const AttributeList& attributes) {
+    TagAction*& action = internedTagList[internedName];
+    if (action == nullptr)
+        action = getTagAction(UTF8String(internedName));
+    else if (action == unknownTagHandler.get())
+        std::cerr << "unknown tag " << UTF8String(internedName) << std::endl;
+    startElement(action, attributes);
+}
 
-        // ???
-        //if (!action->isActivated())
-        //  throw runtime_error("unexpected tag");
-    } else {
-        // add a handler to ignore the text and end element
-        action = unknownTagHandler.get();
-        std::cerr << "unknown tag " << name << std::endl;
+void XMLParser::startElement(TagAction* action, const AttributeList& attributes) {
+    // consume the last tokens before we switch to the next element
+    flushTextLeft();
+
+    if (!trusted) {
+        if (depth > 0 && !stack[depth - 1].subtagAllowed)
+            throw std::runtime_error("this element must not contain any element");
+
+        TagType parentType = parentTagType(action->type);
+        if (parentType != TagType::UNKNOWN) {
+            if (depth == 0)
+                throw std::runtime_error("tag has no parent but it should have one");
+            if (stack[depth - 1].action->type != parentType)
+                throw std::runtime_error("wrong parent for tag");
+        }
     }
 
-    stateStack.push_front(State());
-    actionStack.push_front(action);
+    if (depth == maxDepth)
+        throw std::runtime_error("elements are nested too deeply");
+
+    stack[depth].action = action;
+    stack[depth].subtagAllowed = true;
+    stack[depth].tupleAware = action->tupleAware;
+    depth++;
     action->beginTag(attributes);
 }
 
-void XMLParser::endElement(UTF8String name) {
-    // consume the last tokens
-    if (!textLeft.empty()) {
-        handleAbridgedNotation(textLeft, true);
-        textLeft.clear();
-    }
+void XMLParser::endElement(UTF8String) {
+    endElement();
+}
 
-    TagActionList::iterator iAction = tagList.find(name);
+void XMLParser::endElement() {
+    // consume the last tokens
+    flushTextLeft();
 
-    if (iAction != tagList.end())
-        (*iAction).second->endTag();
+    // the action of the element being closed is the one pushed by startElement
+    TagAction* action = stack[depth - 1].action;
+    if (action != unknownTagHandler.get())
+        action->endTag();
 
-    actionStack.pop_front();
-    stateStack.pop_front();
+    if (depth > 1 && action->type != TagType::BLOCK) {
+        TagType parentType = stack[depth - 2].action->type;
+        if (parentType == TagType::CONSTRAINTS || parentType == TagType::BLOCK)
+            nbConstraints++;
+    }
+    depth--;
 }
 
+namespace {
+    inline bool isWhiteSpace(UTF8String::Byte c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+    }
+} // namespace
+
 void XMLParser::characters(UTF8String chars) {
     //cout << "chars=" << chars << "#" << endl;
 
-    if (actionStack.empty()) {
-        if (chars.isWhiteSpace())
+    if (depth == 0) {
+        if (trusted || chars.isWhiteSpace())
             return;
         else
             throw std::runtime_error("Text found outside any tag");
     }
 
+    // White spaces are ASCII: they can be searched byte by byte, they are never
+    // part of a multi-byte UTF-8 character.
+    const UTF8String::Byte *beg = chars.begin().getPointer(), *end = beg + chars.byteLength();
+
     if (!textLeft.empty()) {
-        // break at first space, concatenate with textLeft and call
-        // text()
-        UTF8String::iterator it = chars.begin(), end = chars.end();
-
-        if (dynamic_cast<ConflictOrSupportTagAction*>(actionStack.front()) != nullptr) {
-            while (it != end && !it.isWhiteSpace() && ((*it) != ')')) {
-                textLeft.append(*it);
-                ++it;
-            }
+        // break at first space (or before ')' in tuples), concatenate with textLeft and call text()
+        const UTF8String::Byte* p = beg;
+        if (stack[depth - 1].tupleAware) {
+            while (p != end && !isWhiteSpace(*p) && *p != ')')
+                ++p;
         } else {
-            while (it != end && !it.isWhiteSpace()) {
-                textLeft.append(*it);
-                ++it;
-            }
-        }
-        while (it != end && it.isWhiteSpace()) {
-            textLeft.append(*it);
-            ++it;
+            while (p != end && !isWhiteSpace(*p))
+                ++p;
         }
+        while (p != end && isWhiteSpace(*p))
+            ++p;
 
-        handleAbridgedNotation(textLeft, false);
+        textLeft.insert(textLeft.end(), beg, p);
+        handleAbridgedNotation(UTF8String(textLeft.data(), textLeft.data() + textLeft.size()), false);
         textLeft.clear();
-
-        chars = chars.substr(it, chars.end());
+        beg = p;
     }
 
     // break after last space, call text() with the first part and
     // store the last part in textLeft
-
-    UTF8String::iterator it, brk;
-
-    brk = chars.end();
-    while (brk != chars.begin()) {
+    const UTF8String::Byte* brk = end;
+    while (brk != beg && !isWhiteSpace(brk[-1]))
         --brk;
-        if (brk.isWhiteSpace()) {
-            ++brk;
-            break;
-        }
-    }
 
-    for (it = brk; it != chars.end(); ++it)
-        textLeft.append(*it);
+    textLeft.assign(brk, end);
+
+    if (brk != beg)
+        handleAbridgedNotation(UTF8String(beg, brk), false);
+}
 
-    chars = chars.substr(chars.begin(), brk);
+void XMLParser::wholeText(UTF8String chars) {
+    if (depth == 0 || !textLeft.empty()) {
+        characters(chars);
+        return;
+    }
 
     if (!chars.empty())
-        handleAbridgedNotation(chars, false);
+        handleAbridgedNotation(chars, true);
 }
 
 void XMLParser::handleAbridgedNotation(UTF8String chars, bool lastChunk) {
-    UTF8String::iterator it, beg, end;
-
-    it = chars.begin();
-    beg = chars.begin();
-    end = chars.end();
-
-    while (it != end) {
-        // skip spaces
-        while (it != end && it.isWhiteSpace())
-            ++it;
-
-        if (it == end)
-            break;
-
-        // no special token
-        while (it != end && !it.isWhiteSpace())
-            ++it;
-    }
-
-    if (beg != end)
-        actionStack.front()->text(chars.substr(beg, end), lastChunk);
+    if (!chars.empty())
+        stack[depth - 1].action->text(chars, lastChunk);
 }
 
 //------------------------------------------------------------------------------------------
@@ -207,40 +223,48 @@ void XMLParser::parseSequence(const UTF8String& txt, std::vector<XVariable*>& li
                 if (dotdot == std::string::npos) {
                     int nb;
                     try { // An integer
-                        nb = std::stoi(current);
-                        XInteger* xi = DataPool::EntityPool.make<XInteger>(current, nb);
+                        nb = toInt(current);
+                        XInteger* xi = DataPool::current().EntityPool.make<XInteger>(current, nb);
                         list.push_back(xi);
 
                     } catch (std::invalid_argument& e) {
-                        if (variablesList[current] != NULL)
-                            list.push_back(static_cast<XVariable*>(variablesList[current]));
-                        else
+                        XEntity* x = variablesList.find(current);
+                        if (x == NULL)
                             throw std::runtime_error("unknown variable: " + current);
+                        list.push_back(static_cast<XVariable*>(x));
                     }
                 } else { // A range
-                    int first = std::stoi(current.substr(0, dotdot));
-                    int last = std::stoi(current.substr(dotdot + 2));
+                    int first = toInt(current.substr(0, dotdot));
+                    int last = toInt(current.substr(dotdot + 2));
                     if (keepIntervals) {
-                        list.push_back(DataPool::EntityPool.make<XEInterval>(current, first, last));
+                        list.push_back(DataPool::current().EntityPool.make<XEInterval>(current, first, last));
                     } else {
                         for (int i = first; i <= last; i++) {
-                            XInteger* xi = DataPool::EntityPool.make<XInteger>(std::to_string(i), i);
+                            XInteger* xi = DataPool::current().EntityPool.make<XInteger>(std::to_string(i), i);
                             list.push_back(xi);
                         }
                     }
                 }
             } else {
+                XEntity* cell = variablesList.find(current); // a single cell: its index is computed directly
+                if (cell != NULL) {
+                    list.push_back(static_cast<XVariable*>(cell));
+                    continue;
+                }
                 std::string name;
                 token.substr(0, pos).to(name);
                 token.substr(pos).to(compactForm);
 
-                if (variablesList[name] == NULL)
+                XEntity* array = variablesList.find(name);
+                if (array == NULL)
                     throw std::runtime_error("unknown variable: " + name);
-                (static_cast<XVariableArray*>(variablesList[name]))->getVarsFor(list, compactForm);
+                (static_cast<XVariableArray*>(array))->getVarsFor(list, compactForm);
             }
         } else {
             // Parameter Variable form group template
-            XParameterVariable* xpv = DataPool::EntityPool.make<XParameterVariable>(current);
+            XParameterVariable* xpv = DataPool::current().EntityPool.make<XParameterVariable>(current);
+            if (maxParameter < xpv->number)
+                maxParameter = xpv->number;
             if (xpv->number == -1)
                 nbParameters = -1;
             else
@@ -252,6 +276,11 @@ void XMLParser::parseSequence(const UTF8String& txt, std::vector<XVariable*>& li
 
 // Return True if START appears;
 bool XMLParser::parseTuples(const UTF8String& txt, std::vector<std::vector<int>>& tuples) {
+    return parseTuples(txt, tuples, currentTuple);
+}
+
+// the tuple being read is given by the caller: it can be split over several texts
+bool XMLParser::parseTuples(const UTF8String& txt, std::vector<std::vector<int>>& tuples, std::vector<int>& tuple) {
     bool hasStar = false;
     UTF8String::Tokenizer tokenizer(txt);
     tokenizer.addSeparator(')');
@@ -262,11 +291,11 @@ bool XMLParser::parseTuples(const UTF8String& txt, std::vector<std::vector<int>>
         if (token == UTF8String(","))
             continue;
         if (token == UTF8String("(")) {
-            currentTuple.clear();
+            tuple.clear();
             continue;
         }
         if (token == UTF8String(")")) {
-            tuples.push_back(std::vector<int>(currentTuple.begin(), currentTuple.end()));
+            tuples.push_back(std::vector<int>(tuple.begin(), tuple.end()));
             continue;
         }
         int val = -1;
@@ -275,11 +304,63 @@ bool XMLParser::parseTuples(const UTF8String& txt, std::vector<std::vector<int>>
             val = STAR;
         } else
             token.to(val);
-        currentTuple.push_back(val);
+        tuple.push_back(val);
     }
     return hasStar;
 }
 
+namespace {
+    // below this size (in bytes), a segment of tuples is not worth a thread
+    const size_t minTuplesSegment = 1 << 18;
+} // namespace
+
+bool XMLParser::parseTuplesInParallel(const UTF8String& txt, std::vector<std::vector<int>>& tuples) {
+    const UTF8String::Byte *beg = txt.begin().getPointer(), *end = beg + txt.byteLength();
+    size_t nbSegments = std::min(static_cast<size_t>(threads), txt.byteLength() / minTuplesSegment);
+    if (nbSegments < 2)
+        return parseTuples(txt, tuples);
+
+    // a segment starts with a '(' (or with the text), so that no tuple is cut
+    std::vector<const UTF8String::Byte*> bounds(nbSegments + 1, end);
+    bounds[0] = beg;
+    for (size_t i = 1; i < nbSegments; i++)
+        bounds[i] = std::find(std::max(bounds[i - 1], beg + i * (end - beg) / nbSegments), end, '(');
+
+    std::vector<std::vector<std::vector<int>>> segments(nbSegments);
+    std::vector<char> stars(nbSegments, false);
+    std::vector<std::exception_ptr> errors(nbSegments);
+    auto parseSegment = [&](size_t i) {
+        try {
+            std::vector<int> tuple;
+            stars[i] = parseTuples(UTF8String(bounds[i], bounds[i + 1]), segments[i], tuple);
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < nbSegments; i++)
+        workers.emplace_back(parseSegment, i);
+    parseSegment(0);
+    for (std::thread& worker : workers)
+        worker.join();
+
+    bool hasStar = false;
+    size_t nbTuples = tuples.size();
+    for (size_t i = 0; i < nbSegments; i++) {
+        if (errors[i])
+            std::rethrow_exception(errors[i]);
+        hasStar |= stars[i] != 0;
+        nbTuples += segments[i].size();
+    }
+
+    // the tuples are moved, not copied
+    tuples.reserve(nbTuples);
+    for (std::vector<std::vector<int>>& segment : segments)
+        tuples.insert(tuples.end(), std::make_move_iterator(segment.begin()), std::make_move_iterator(segment.end()));
+    return hasStar;
+}
+
 void XMLParser::parseDomain(const UTF8String& txt, XDomainInteger& domain) {
     UTF8String::Tokenizer tokenizer(txt);
     UTF8String dotdot("..");
@@ -321,7 +402,7 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String& txt, std::vector<
                 txt.to(ds);
                 throw std::runtime_error("Integer expected: " + ds);
             }
-            XIntegerValue* xv = DataPool::IntegerEntityPool.make<XIntegerValue>(val);
+            XIntegerValue* xv = DataPool::current().IntegerEntityPool.make<XIntegerValue>(val);
             listToFill.push_back(xv);
         } else {
             int first, last;
@@ -330,7 +411,7 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String& txt, std::vector<
                 txt.to(ds);
                 throw std::runtime_error("Integer expected: " + ds);
             }
-            XIntegerInterval* xi = DataPool::IntegerEntityPool.make<XIntegerInterval>(first, last);
+            XIntegerInterval* xi = DataPool::current().IntegerEntityPool.make<XIntegerInterval>(first, last);
             listToFill.push_back(xi);
         }
     }
@@ -342,95 +423,100 @@ void XMLParser::parseListOfIntegerOrInterval(const UTF8String& txt, std::vector<
 
 XMLParser::XMLParser(XCSP3CoreCallbacksBase* cb) {
     keepIntervals = false;
+    trusted = false;
+    threads = 1;
+    nbConstraints = 0;
+    maxParameter = -1;
+    depth = 0;
     this->manager.reset(new XCSP3Manager(cb, variablesList));
     unknownTagHandler.reset(new UnknownTagAction(this, "unknown"));
 
-    registerTagAction(tagList, new InstanceTagAction(this, "instance"));
+    registerTagAction(new InstanceTagAction(this, "instance"));
 
-    registerTagAction(tagList, new VariablesTagAction(this, "variables"));
-    registerTagAction(tagList, varTagAction = new VarTagAction(this, "var"));
-    registerTagAction(tagList, new ArrayTagAction(this, "array"));
-    registerTagAction(tagList, new DomainTagAction(this, "domain"));
+    registerTagAction(new VariablesTagAction(this, "variables"));
+    registerTagAction(varTagAction = new VarTagAction(this, "var"));
+    registerTagAction(new ArrayTagAction(this, "array"));
+    registerTagAction(new DomainTagAction(this, "domain"));
 
-    registerTagAction(tagList, new AnnotationsTagAction(this, "annotations"));
-    registerTagAction(tagList, new DecisionTagAction(this, "decision"));
+    registerTagAction(new AnnotationsTagAction(this, "annotations"));
+    registerTagAction(new DecisionTagAction(this, "decision"));
 
-    registerTagAction(tagList, new ConstraintsTagAction(this, "constraints"));
+    registerTagAction(new ConstraintsTagAction(this, "constraints"));
 
-    registerTagAction(tagList, new ExtensionTagAction(this, "extension"));
-    registerTagAction(tagList, this->listTag = new ListTagAction(this, "list"));
-    registerTagAction(tagList, new ConflictOrSupportTagAction(this, "supports"));
-    registerTagAction(tagList, new ConflictOrSupportTagAction(this, "conflicts"));
+    registerTagAction(new ExtensionTagAction(this, "extension"));
+    registerTagAction(this->listTag = new ListTagAction(this, "list"));
+    registerTagAction(new ConflictOrSupportTagAction(this, "supports"));
+    registerTagAction(new ConflictOrSupportTagAction(this, "conflicts"));
 
-    registerTagAction(tagList, new IntensionTagAction(this, "intension"));
+    registerTagAction(new IntensionTagAction(this, "intension"));
 
-    registerTagAction(tagList, new AllDiffEqualTagAction(this, "allDifferent"));
-    registerTagAction(tagList, new AllDiffEqualTagAction(this, "allEqual"));
+    registerTagAction(new AllDiffEqualTagAction(this, "allDifferent"));
+    registerTagAction(new AllDiffEqualTagAction(this, "allEqual"));
 
-    registerTagAction(tagList, new SumTagAction(this, "sum"));
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "coeffs", this->values));
-    registerTagAction(tagList, new ConditionTagAction(this, "condition"));
+    registerTagAction(new SumTagAction(this, "sum"));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "coeffs", this->values));
+    registerTagAction(new ConditionTagAction(this, "condition"));
 
-    registerTagAction(tagList, new OrderedTagAction(this, "ordered"));
+    registerTagAction(new OrderedTagAction(this, "ordered"));
 
-    registerTagAction(tagList, new ChannelTagAction(this, "channel"));
+    registerTagAction(new ChannelTagAction(this, "channel"));
 
-    registerTagAction(tagList, new LexTagAction(this, "lex"));
+    registerTagAction(new LexTagAction(this, "lex"));
 
-    registerTagAction(tagList, new CountTagAction(this, "count"));
-    registerTagAction(tagList, new CardinalityTagAction(this, "cardinality"));
+    registerTagAction(new CountTagAction(this, "count"));
+    registerTagAction(new CardinalityTagAction(this, "cardinality"));
 
     // Value and Values are quite identical
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "values", this->values));
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "value", this->values));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "values", this->values));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "value", this->values));
 
-    registerTagAction(tagList, new NValuesTagAction(this, "nValues"));
-    registerTagAction(tagList, new InstantiationTagAction(this, "instantiation"));
+    registerTagAction(new NValuesTagAction(this, "nValues"));
+    registerTagAction(new InstantiationTagAction(this, "instantiation"));
 
-    registerTagAction(tagList, new GroupTagAction(this, "group"));
-    registerTagAction(tagList, new ArgsTagAction(this, "args"));
+    registerTagAction(new GroupTagAction(this, "group"));
+    registerTagAction(new ArgsTagAction(this, "args"));
 
-    registerTagAction(tagList, new MinMaxTagAction(this, "minimum"));
-    registerTagAction(tagList, new MinMaxTagAction(this, "maximum"));
+    registerTagAction(new MinMaxTagAction(this, "minimum"));
+    registerTagAction(new MinMaxTagAction(this, "maximum"));
 
-    registerTagAction(tagList, new IndexTagAction(this, "index"));
+    registerTagAction(new IndexTagAction(this, "index"));
 
-    registerTagAction(tagList, new ElementTagAction(this, "element"));
+    registerTagAction(new ElementTagAction(this, "element"));
 
-    registerTagAction(tagList, new NoOverlapTagAction(this, "noOverlap"));
-    registerTagAction(tagList, new CumulativeTagAction(this, "cumulative"));
-    registerTagAction(tagList, new OriginsTagAction(this, "origins", this->origins));
-    registerTagAction(tagList, new OriginsTagAction(this, "lengths", this->lengths));
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "ends", this->ends));
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "heights", this->heights));
+    registerTagAction(new NoOverlapTagAction(this, "noOverlap"));
+    registerTagAction(new CumulativeTagAction(this, "cumulative"));
+    registerTagAction(new OriginsTagAction(this, "origins", this->origins));
+    registerTagAction(new OriginsTagAction(this, "lengths", this->lengths));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "ends", this->ends));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "heights", this->heights));
 
-    registerTagAction(tagList, new ListOfVariablesOrIntegerOrIntervalTagAction(this, "occurs", this->occurs));
-    registerTagAction(tagList, new StretchTagAction(this, "stretch"));
-    registerTagAction(tagList, new ListOfIntegerOrIntervalTagAction(this, "widths", this->widths));
+    registerTagAction(new ListOfVariablesOrIntegerOrIntervalTagAction(this, "occurs", this->occurs));
+    registerTagAction(new StretchTagAction(this, "stretch"));
+    registerTagAction(new ListOfIntegerOrIntervalTagAction(this, "widths", this->widths));
 
-    registerTagAction(tagList, new OperatorTagAction(this, "operator"));
+    registerTagAction(new OperatorTagAction(this, "operator"));
 
-    registerTagAction(tagList, new RegularTagAction(this, "regular"));
-    registerTagAction(tagList, new MDDTagAction(this, "mdd"));
-    registerTagAction(tagList, new StringTagAction(this, "start"));
-    registerTagAction(tagList, new StringTagAction(this, "final"));
-    registerTagAction(tagList, new TransitionsTagAction(this, "transitions"));
-    registerTagAction(tagList, new PatternsTagAction(this, "patterns"));
+    registerTagAction(new RegularTagAction(this, "regular"));
+    registerTagAction(new MDDTagAction(this, "mdd"));
+    registerTagAction(new StringTagAction(this, "start"));
+    registerTagAction(new StringTagAction(this, "final"));
+    registerTagAction(new TransitionsTagAction(this, "transitions"));
+    registerTagAction(new PatternsTagAction(this, "patterns"));
 
-    registerTagAction(tagList, new ClauseTagAction(this, "clause"));
+    registerTagAction(new ClauseTagAction(this, "clause"));
 
-    registerTagAction(tagList, new ObjectivesTagAction(this, "objectives"));
-    registerTagAction(tagList, new MinimizeOrMaximizeTagAction(this, "minimize"));
-    registerTagAction(tagList, new MinimizeOrMaximizeTagAction(this, "maximize"));
+    registerTagAction(new ObjectivesTagAction(this, "objectives"));
+    registerTagAction(new MinimizeOrMaximizeTagAction(this, "minimize"));
+    registerTagAction(new MinimizeOrMaximizeTagAction(this, "maximize"));
 
-    registerTagAction(tagList, new ListOfIntegerTagAction(this, "except"));
-    registerTagAction(tagList, new MatrixTagAction(this, "matrix"));
+    registerTagAction(new ListOfIntegerTagAction(this, "except"));
+    registerTagAction(new MatrixTagAction(this, "matrix"));
 
-    registerTagAction(tagList, new BlockTagAction(this, "block"));
-    registerTagAction(tagList, new SlideTagAction(this, "slide"));
+    registerTagAction(new BlockTagAction(this, "block"));
+    registerTagAction(new SlideTagAction(this, "slide"));
 
-    registerTagAction(tagList, new CircuitTagAction(this, "circuit"));
-    registerTagAction(tagList, new ListOfVariablesOrIntegerTagAction(this, "size", this->values));
+    registerTagAction(new CircuitTagAction(this, "circuit"));
+    registerTagAction(new ListOfVariablesOrIntegerTagAction(this, "size", this->values));
 }
 
 XMLParser::~XMLParser() {
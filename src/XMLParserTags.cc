@@ -35,7 +35,7 @@ using namespace XCSP3Core;
 void XMLParser::InstanceTagAction::beginTag(const AttributeList& attributes) {
     std::string stringtype;
     InstanceType type;
-    if (!attributes["type"].to(stringtype))
+    if (!attributes[AttributeType::TYPE].to(stringtype))
         throw std::runtime_error("expected attribute type for tag <instance>");
 
     if (stringtype == "COP")
@@ -58,7 +58,6 @@ void XMLParser::InstanceTagAction::endTag() {
 
 // AttributeList &attributes
 void XMLParser::VariablesTagAction::beginTag(const AttributeList&) {
-    this->checkParentTag("instance");
     this->parser->manager->beginVariables();
 }
 
@@ -73,40 +72,40 @@ void XMLParser::VariablesTagAction::endTag() {
 void XMLParser::VarTagAction::beginTag(const AttributeList& attributes) {
     std::string type, as, lid;
 
-    this->checkParentTag("variables");
-    this->parser->stateStack.front().subtagAllowed = false;
-    if (variable != NULL)
-        variable = NULL;
+    this->parser->stack[this->parser->depth - 1].subtagAllowed = false;
+    variable = NULL;
+    variableArray = NULL;
 
-    if (!attributes["id"].to(lid))
+    if (!attributes[AttributeType::ID].to(lid))
         throw std::runtime_error("expected attribute id for tag <var>");
     id = lid;
 
-    if (!attributes["class"].isNull())
-        attributes["class"].to(classes);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(classes);
     else
         classes = "";
 
-    if (!attributes["type"].isNull()) {
-        attributes["type"].to(type);
+    if (!attributes[AttributeType::TYPE].isNull()) {
+        attributes[AttributeType::TYPE].to(type);
         if (type != "integer")
             throw std::runtime_error("XCSP3Core expected type=\"integer\" for tag <var>");
     }
-    if (!attributes["as"].isNull()) {
+    if (!attributes[AttributeType::AS].isNull()) {
         // Create a similar Variable
-        attributes["as"].to(as);
+        attributes[AttributeType::AS].to(as);
         XVariableArray* similarArray;
-        if (this->parser->variablesList[as] == NULL)
+        XEntity* entity = this->parser->variablesList.find(as);
+        if (entity == NULL)
             throw std::runtime_error("Variable as \"" + as + "\" does not exist");
-        if ((similarArray = dynamic_cast<XVariableArray*>(this->parser->variablesList[as])) != NULL) {
-            variableArray = DataPool::EntityPool.make<XVariableArray>(id, similarArray);
+        if ((similarArray = dynamic_cast<XVariableArray*>(entity)) != NULL) {
+            variableArray = DataPool::current().EntityPool.make<XVariableArray>(id, similarArray);
         } else {
-            XVariable* similar = static_cast<XVariable*>(this->parser->variablesList[as]);
-            variable = DataPool::EntityPool.make<XVariable>(id, similar->domain);
+            XVariable* similar = static_cast<XVariable*>(entity);
+            variable = DataPool::current().EntityPool.make<XVariable>(id, similar->domain);
         }
     } else {
-        domain = DataPool::DomainPool.make<XDomainInteger>();
-        this->parser->allDomains.emplace_back(domain);
+        parsed.clear();
+        domain = &parsed;
     }
 }
 
@@ -121,17 +120,15 @@ void XMLParser::VarTagAction::text(const UTF8String txt, bool) {
 void XMLParser::VarTagAction::endTag() {
     if (variableArray != NULL) { // SImulate an array
         this->parser->manager->beginVariableArray(variableArray->id);
-        this->parser->variablesList[variableArray->id] = variableArray;
-        for (XVariable* x : variableArray->variables)
-            this->parser->variablesList[x->id] = x;
+        this->parser->variablesList.add(variableArray);
         this->parser->manager->buildVariableArray(variableArray);
         this->parser->manager->endVariableArray();
         return;
     }
     if (variable == NULL)
-        variable = DataPool::EntityPool.make<XVariable>(id, domain);
+        variable = DataPool::current().EntityPool.make<XVariable>(id, this->parser->domains.intern(parsed));
     variable->classes = classes;
-    this->parser->variablesList[variable->id] = variable;
+    this->parser->variablesList.add(variable);
     this->parser->manager->buildVariable(variable);
 }
 
@@ -142,45 +139,44 @@ void XMLParser::VarTagAction::endTag() {
 void XMLParser::ArrayTagAction::beginTag(const AttributeList& attributes) {
     std::string type, as, lid, size;
 
-    this->checkParentTag("variables");
     domain = NULL;
     sizes.clear();
 
-    if (!attributes["id"].to(lid))
+    if (!attributes[AttributeType::ID].to(lid))
         throw std::runtime_error("expected attribute id for tag <array>");
     id = lid;
 
-    if (!attributes["class"].isNull())
-        attributes["class"].to(classes);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(classes);
     else
         classes = "";
 
-    if (!attributes["type"].isNull()) {
-        attributes["type"].to(type);
+    if (!attributes[AttributeType::TYPE].isNull()) {
+        attributes[AttributeType::TYPE].to(type);
         if (type != "integer")
             throw std::runtime_error("XCSP3Core expected type=\"integer\" for tag <var>");
     }
 
-    if (!attributes["as"].isNull()) {
+    if (!attributes[AttributeType::AS].isNull()) {
         // Create a similar Variable
-        attributes["as"].to(as);
-        if (this->parser->variablesList[as] == nullptr)
+        attributes[AttributeType::AS].to(as);
+        XVariableArray* similar = static_cast<XVariableArray*>(this->parser->variablesList.find(as));
+        if (similar == nullptr)
             throw std::runtime_error("Matrix variable as \"" + as + "\" does not exist");
-        XVariableArray* similar = static_cast<XVariableArray*>(this->parser->variablesList[as]);
-        varArray = DataPool::EntityPool.make<XVariableArray>(id, similar);
+        varArray = DataPool::current().EntityPool.make<XVariableArray>(id, similar);
     } else {
-        if (!attributes["size"].to(size))
+        if (!attributes[AttributeType::SIZE].to(size))
             throw std::runtime_error("expected attribute id for tag <array>");
         std::vector<std::string> stringSizes = split(size, '[');
         for (unsigned int i = 0; i < stringSizes.size(); i++) {
             if (stringSizes[i].size() == 0)
                 continue;
-            sizes.push_back(std::stoi(stringSizes[i].substr(0, stringSizes[i].size() - 1)));
+            sizes.push_back(toInt(stringSizes[i].substr(0, stringSizes[i].size() - 1)));
         }
-        varArray = DataPool::EntityPool.make<XVariableArray>(id, sizes);
+        varArray = DataPool::current().EntityPool.make<XVariableArray>(id, sizes);
 
-        domain = DataPool::DomainPool.make<XDomainInteger>();
-        this->parser->allDomains.push_back(domain);
+        parsed.clear();
+        domain = &parsed;
         this->parser->manager->beginVariableArray(id);
     }
 
@@ -188,26 +184,20 @@ void XMLParser::ArrayTagAction::beginTag(const AttributeList& attributes) {
 }
 
 void XMLParser::ArrayTagAction::endTag() {
-    if (domain != nullptr && domain->nbValues() != 0) // If dommain is null -> as variable // Possible empty variables
-        varArray->buildVarsWith(domain);
-    this->parser->variablesList[varArray->id] = DataPool::EntityPool.make<XVariableArray>(*varArray);
-    for (XVariable* x : varArray->variables) {
-        if (x == nullptr) // Undefined variable
-            continue;
-        this->parser->variablesList[x->id] = x;
-    }
+    if (domain != nullptr) // If dommain is null -> as variable // Possible empty variables
+        varArray->endDomains(domain->nbValues() != 0 ? this->parser->domains.intern(parsed) : nullptr);
+    this->parser->variablesList.add(varArray);
     this->parser->manager->buildVariableArray(varArray);
     this->parser->manager->endVariableArray();
 }
 
 void XMLParser::DomainTagAction::beginTag(const AttributeList& attributes) {
-    this->checkParentTag("array");
-    attributes["for"].to(forAttr);
+    attributes[AttributeType::FOR].to(forAttr);
     if (forAttr == "others")
         d = static_cast<XMLParser::ArrayTagAction*>(this->parser->getParentTagAction())->domain;
     else {
-        d = DataPool::DomainPool.make<XDomainInteger>();
-        this->parser->allDomains.push_back(d);
+        parsed.clear();
+        d = &parsed;
     }
 }
 
@@ -220,23 +210,16 @@ void XMLParser::DomainTagAction::endTag() {
     if (forAttr == "others")
         return;
 
-    std::string name;
     std::vector<std::string> allCompactForms;
-    std::vector<XVariable*> vars;
     XVariableArray* varArray = static_cast<XMLParser::ArrayTagAction*>(this->parser->getParentTagAction())->varArray;
+    XDomainInteger* domain = this->parser->domains.intern(parsed);
 
     split(forAttr, ' ', allCompactForms);
     for (unsigned int i = 0; i < allCompactForms.size(); i++) {
-        int pos = allCompactForms[i].find('[');
-        name = allCompactForms[i].substr(0, pos);
-        std::string compactForm = allCompactForms[i].substr(pos);
-        std::vector<int> flatIndexes;
-        std::vector<int> indexes;
-        varArray->getVarsFor(vars, compactForm, &flatIndexes, true);
-        for (unsigned int j = 0; j < flatIndexes.size(); j++) {
-            varArray->indexesFor(flatIndexes[j], indexes);
-            varArray->variables[flatIndexes[j]] = DataPool::EntityPool.make<XVariable>(varArray->id, d, indexes);
-        }
+        size_t pos = allCompactForms[i].find('[');
+        if (pos == std::string::npos)
+            throw std::runtime_error("Bad compact form in <domain for=...>: " + allCompactForms[i]);
+        varArray->addDomain(allCompactForms[i].substr(pos), domain);
     }
 }
 
@@ -245,39 +228,37 @@ void XMLParser::BasicConstraintTagAction::beginTag(const AttributeList& attribut
     this->parser->star = false;
 
     // Classic group
-    if (strcmp(this->parser->getParentTagAction()->getTagName(), "group") == 0)
+    if (this->hasParentTag(TagType::GROUP))
         group = static_cast<XMLParser::GroupTagAction*>(this->parser->getParentTagAction())->group;
 
     // Group with meta constraint not or block
-    if (strcmp(this->parser->getParentTagAction(2)->getTagName(), "group") == 0) {
+    if (this->hasParentTag(TagType::GROUP, 2)) {
         group = static_cast<XMLParser::GroupTagAction*>(this->parser->getParentTagAction(2))->group;
         exit(1);
     }
 
     // Group with not and block
-    if (this->parser->getParentTagAction(3) != NULL &&
-        strcmp(this->parser->getParentTagAction(3)->getTagName(), "group") == 0)
+    if (this->hasParentTag(TagType::GROUP, 3))
         group = static_cast<XMLParser::GroupTagAction*>(this->parser->getParentTagAction(3))->group;
 
     // Slide constraint (special cases of group without args)
-    if (strcmp(this->parser->getParentTagAction()->getTagName(), "slide") == 0)
+    if (this->hasParentTag(TagType::SLIDE))
         group = static_cast<XMLParser::SlideTagAction*>(this->parser->getParentTagAction())->group;
 
     // Group with meta constraint not or block
-    if (strcmp(this->parser->getParentTagAction(2)->getTagName(), "slide") == 0) {
+    if (this->hasParentTag(TagType::SLIDE, 2)) {
         group = static_cast<XMLParser::SlideTagAction*>(this->parser->getParentTagAction(2))->group;
         exit(1);
     }
 
     // Group with not and block
-    if (this->parser->getParentTagAction(3) != NULL &&
-        strcmp(this->parser->getParentTagAction(3)->getTagName(), "slide") == 0)
+    if (this->hasParentTag(TagType::SLIDE, 3))
         group = static_cast<XMLParser::SlideTagAction*>(this->parser->getParentTagAction(3))->group;
 
-    attributes["id"].to(id);
+    attributes[AttributeType::ID].to(id);
 
-    if (!attributes["class"].isNull())
-        attributes["class"].to(this->parser->classes);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(this->parser->classes);
     else
         this->parser->classes = "";
 
@@ -314,7 +295,7 @@ void XMLParser::ExtensionTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintExtension>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintExtension>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -345,7 +326,7 @@ void XMLParser::IntensionTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintIntension>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintIntension>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -384,7 +365,7 @@ void XMLParser::RegularTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintRegular>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintRegular>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -414,7 +395,7 @@ void XMLParser::MDDTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintMDD>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintMDD>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -451,17 +432,17 @@ void XMLParser::AllDiffEqualTagAction::beginTag(const AttributeList& attributes)
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    if (this->tagName == "allDifferent") {
-        alldiff = DataPool::ConstraintPool.make<XConstraintAllDiff>(this->id, this->parser->classes);
+    if (this->type == TagType::ALLDIFFERENT) {
+        alldiff = DataPool::current().ConstraintPool.make<XConstraintAllDiff>(this->id, this->parser->classes);
         ct = alldiff;
     } else {
-        allequal = DataPool::ConstraintPool.make<XConstraintAllEqual>(this->id, this->parser->classes);
+        allequal = DataPool::current().ConstraintPool.make<XConstraintAllEqual>(this->id, this->parser->classes);
         ct = allequal;
     }
 
     // Link constraint to group
     if (this->group != NULL) {
-        if (this->tagName == "allDifferent")
+        if (this->type == TagType::ALLDIFFERENT)
             this->group->type = ConstraintType::ALLDIFF;
         else
             this->group->type = ConstraintType::ALLEQUAL;
@@ -479,18 +460,18 @@ void XMLParser::AllDiffEqualTagAction::endTag() {
         throw std::runtime_error("AllDiff matrix and AllDiff lists are not implemented with groups");
 
     if (this->group == NULL) {
-        if (this->tagName == "allDifferent") {
+        if (this->type == TagType::ALLDIFFERENT) {
             if (this->parser->lists.size() > 1) {
                 if (this->parser->integers.size() > 0) // Except not implemented
                     throw std::runtime_error("except tag not allowed with alldiff on lists");
 
-                XConstraintAllDiffList* ctl = DataPool::ConstraintPool.make<XConstraintAllDiffList>(this->id, this->parser->classes);
+                XConstraintAllDiffList* ctl = DataPool::current().ConstraintPool.make<XConstraintAllDiffList>(this->id, this->parser->classes);
                 for (unsigned int i = 0; i < this->parser->lists.size(); i++)
                     ctl->matrix.push_back(std::vector<XVariable*>(this->parser->lists[i].begin(), this->parser->lists[i].end()));
                 this->parser->manager->newConstraintAllDiffList(ctl);
             } else {
                 if (this->parser->matrix.size() > 0) { // Matrix
-                    XConstraintAllDiffMatrix* ctm = DataPool::ConstraintPool.make<XConstraintAllDiffMatrix>(this->id, this->parser->classes, this->parser->matrix);
+                    XConstraintAllDiffMatrix* ctm = DataPool::current().ConstraintPool.make<XConstraintAllDiffMatrix>(this->id, this->parser->classes, this->parser->matrix);
                     this->parser->manager->newConstraintAllDiffMatrix(ctm);
                 } else {
                     // Alldiff classic
@@ -521,9 +502,9 @@ void XMLParser::OrderedTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintOrdered>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintOrdered>(this->id, this->parser->classes);
     std::string cs;
-    attributes["case"].to(cs);
+    attributes[AttributeType::CASE].to(cs);
     if (cs == "strictlyDecreasing")
         this->parser->op = OrderType::GT;
     if (cs == "decreasing")
@@ -564,7 +545,7 @@ void XMLParser::LexTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintLex>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintLex>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -575,7 +556,7 @@ void XMLParser::LexTagAction::beginTag(const AttributeList& attributes) {
 
 void XMLParser::LexTagAction::endTag() {
     if (this->parser->matrix.size() > 0) {
-        XConstraintLexMatrix* lexM = DataPool::ConstraintPool.make<XConstraintLexMatrix>(this->id, this->parser->classes);
+        XConstraintLexMatrix* lexM = DataPool::current().ConstraintPool.make<XConstraintLexMatrix>(this->id, this->parser->classes);
         lexM->op = this->parser->op;
         for (unsigned int i = 0; i < this->parser->matrix.size(); i++)
             lexM->matrix.push_back(
@@ -611,7 +592,7 @@ void XMLParser::SumTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintSum>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintSum>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -643,7 +624,7 @@ void XMLParser::NValuesTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintNValues>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintNValues>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -670,7 +651,7 @@ void XMLParser::CountTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintCount>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintCount>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -697,7 +678,7 @@ void XMLParser::CardinalityTagAction::beginTag(const AttributeList& attributes)
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
     this->parser->closed = false;
-    constraint = DataPool::ConstraintPool.make<XConstraintCardinality>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintCardinality>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -730,7 +711,7 @@ void XMLParser::ChannelTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintChannel>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintChannel>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -773,7 +754,7 @@ void XMLParser::ElementTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintElement>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintElement>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -794,7 +775,7 @@ void XMLParser::ElementTagAction::endTag() {
 
     XConstraintElementMatrix* c;
     if (this->parser->matrix.size() > 0) {
-        c = DataPool::ConstraintPool.make<XConstraintElementMatrix>(this->id, this->parser->classes, this->parser->matrix);
+        c = DataPool::current().ConstraintPool.make<XConstraintElementMatrix>(this->id, this->parser->classes, this->parser->matrix);
         c->value = this->parser->values[0];
         c->index = this->parser->index;
         c->rank = this->parser->rank;
@@ -827,12 +808,12 @@ void XMLParser::MinMaxTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintMaximum>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintMaximum>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
         this->group->constraint = constraint;
-        if (this->tagName == "maximum")
+        if (this->type == TagType::MAXIMUM)
             this->group->type = ConstraintType::MAXIMUM;
         else
             this->group->type = ConstraintType::MINIMUM;
@@ -847,7 +828,7 @@ void XMLParser::MinMaxTagAction::endTag() {
     constraint->rank = this->parser->rank;
 
     if (this->group == NULL) {
-        if (this->tagName == "maximum")
+        if (this->type == TagType::MAXIMUM)
             this->parser->manager->newConstraintMaximum(constraint);
         else
             this->parser->manager->newConstraintMinimum(constraint);
@@ -867,7 +848,7 @@ void XMLParser::MinMaxTagAction::endTag() {
 void XMLParser::StretchTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
-    constraint = DataPool::ConstraintPool.make<XConstraintStretch>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintStretch>(this->id, this->parser->classes);
     // Link constraint to group
     if (this->group != NULL) {
         this->group->constraint = constraint;
@@ -908,10 +889,10 @@ void XMLParser::NoOverlapTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
     diffn = false;
-    constraint = DataPool::ConstraintPool.make<XConstraintNoOverlap>(this->id, this->parser->classes);
-    if (!attributes["zeroIgnored"].isNull()) {
+    constraint = DataPool::current().ConstraintPool.make<XConstraintNoOverlap>(this->id, this->parser->classes);
+    if (!attributes[AttributeType::ZEROIGNORED].isNull()) {
         std::string tmp;
-        attributes["zeroIgnored"].to(tmp);
+        attributes[AttributeType::ZEROIGNORED].to(tmp);
         this->parser->zeroIgnored = (tmp == "true");
     } else
         this->parser->zeroIgnored = true;
@@ -941,7 +922,7 @@ void XMLParser::CumulativeTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintCumulative>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintCumulative>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -971,7 +952,7 @@ void XMLParser::CumulativeTagAction::endTag() {
 void XMLParser::CircuitTagAction::beginTag(const AttributeList& attributes) {
     BasicConstraintTagAction::beginTag(attributes);
 
-    constraint = DataPool::ConstraintPool.make<XConstraintCircuit>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintCircuit>(this->id, this->parser->classes);
 
     // Link constraint to group
     if (this->group != NULL) {
@@ -1011,9 +992,8 @@ void XMLParser::CircuitTagAction::endTag() {
 
 // AttributeList &attributes
 void XMLParser::ObjectivesTagAction::beginTag(const AttributeList&) {
-    objective = DataPool::ObjectivePool.make<XObjective>();
+    objective = DataPool::current().ObjectivePool.make<XObjective>();
     this->parser->expr = "";
-    this->checkParentTag("instance");
     this->parser->lists.clear();
     this->parser->listTag->nbCallsToList = 0;
     this->parser->integers.clear();
@@ -1044,11 +1024,10 @@ void XMLParser::ObjectivesTagAction::endTag() {
 
 void XMLParser::MinimizeOrMaximizeTagAction::beginTag(const AttributeList& attributes) {
     obj = static_cast<XMLParser::ObjectivesTagAction*>(this->parser->getParentTagAction())->objective;
-    obj->goal = (this->tagName == "minimize") ? ObjectiveGoal::MINIMIZE : ObjectiveGoal::MAXIMIZE;
+    obj->goal = (this->type == TagType::MINIMIZE) ? ObjectiveGoal::MINIMIZE : ObjectiveGoal::MAXIMIZE;
     std::string tmp;
-    this->checkParentTag("objectives");
 
-    attributes["type"].to(tmp);
+    attributes[AttributeType::TYPE].to(tmp);
     obj->type = ExpressionObjective::EXPRESSION_O;
     if (tmp == "sum")
         obj->type = ExpressionObjective::SUM_O;
@@ -1095,9 +1074,9 @@ void XMLParser::ListOfIntegerTagAction::text(const UTF8String txt, bool) {
 void XMLParser::ListOfVariablesOrIntegerTagAction::beginTag(const AttributeList& attributes) {
 
     listToFill.clear();
-    if (!attributes["closed"].isNull()) {
+    if (!attributes[AttributeType::CLOSED].isNull()) {
         std::string tmp;
-        attributes["closed"].to(tmp);
+        attributes[AttributeType::CLOSED].to(tmp);
         this->parser->closed = (tmp == "true");
     }
 }
@@ -1193,10 +1172,10 @@ void XMLParser::StringTagAction::text(const UTF8String txt, bool) {
     tmp = trim(tmp);
     if (tmp == "")
         return;
-    if (this->tagName == "final") {
+    if (this->type == TagType::FINAL) {
         this->parser->final = tmp;
     }
-    if (this->tagName == "start")
+    if (this->type == TagType::START)
         this->parser->start = tmp;
 }
 
@@ -1207,7 +1186,7 @@ void XMLParser::StringTagAction::text(const UTF8String txt, bool) {
 void XMLParser::InstantiationTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
-    constraint = DataPool::ConstraintPool.make<XConstraintInstantiation>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintInstantiation>(this->id, this->parser->classes);
     // Link constraint to group
     if (this->group != NULL) {
         this->group->constraint = constraint;
@@ -1235,7 +1214,7 @@ void XMLParser::InstantiationTagAction::endTag() {
 void XMLParser::ClauseTagAction::beginTag(const AttributeList& attributes) {
     // Must be called inside a constraint
     BasicConstraintTagAction::beginTag(attributes);
-    constraint = DataPool::ConstraintPool.make<XConstraintClause>(this->id, this->parser->classes);
+    constraint = DataPool::current().ConstraintPool.make<XConstraintClause>(this->id, this->parser->classes);
     literals.clear();
     // Link constraint to group
     if (this->group != NULL) {
@@ -1264,18 +1243,18 @@ void XMLParser::ClauseTagAction::endTag() {
             size_t p = current.find('(');
 
             if (p == std::string::npos) {
-                if (this->parser->variablesList[current] != NULL)
-                    constraint->positive.push_back(static_cast<XVariable*>(this->parser->variablesList[current]));
-                else
+                XEntity* x = this->parser->variablesList.find(current);
+                if (x == NULL)
                     throw std::runtime_error("unknown variable: " + current);
+                constraint->positive.push_back(static_cast<XVariable*>(x));
             } else {
                 assert(p == 3);
                 std::string v = current.substr(p + 1, current.size() - p - 2);
 
-                if (this->parser->variablesList[v] != NULL)
-                    constraint->negative.push_back(static_cast<XVariable*>(this->parser->variablesList[v]));
-                else
+                XEntity* x = this->parser->variablesList.find(v);
+                if (x == NULL)
                     throw std::runtime_error("unknown variable: " + v);
+                constraint->negative.push_back(static_cast<XVariable*>(x));
             }
         }
         if (constraint->positive.size() == 0 && constraint->negative.size() == 0)
@@ -1289,16 +1268,16 @@ void XMLParser::ListTagAction::beginTag(const AttributeList& attributes) {
     if (nbCallsToList > 1) {
         this->parser->lists.push_back(std::vector<XVariable*>());
         this->parser->startIndex2 = 0;
-        if (!attributes["startIndex"].isNull())
-            attributes["startIndex"].to(this->parser->startIndex2);
+        if (!attributes[AttributeType::STARTINDEX].isNull())
+            attributes[AttributeType::STARTINDEX].to(this->parser->startIndex2);
     } else {
         this->parser->startIndex = 0;
-        if (!attributes["startIndex"].isNull())
-            attributes["startIndex"].to(this->parser->startIndex);
+        if (!attributes[AttributeType::STARTINDEX].isNull())
+            attributes[AttributeType::STARTINDEX].to(this->parser->startIndex);
     }
-    if (!attributes["offset"].isNull()) {
+    if (!attributes[AttributeType::OFFSET].isNull()) {
         SlideTagAction* slide = static_cast<XMLParser::SlideTagAction*>(this->parser->getParentTagAction());
-        attributes["offset"].to(slide->offset);
+        attributes[AttributeType::OFFSET].to(slide->offset);
     }
 }
 
@@ -1308,8 +1287,7 @@ void XMLParser::ListTagAction::text(const UTF8String txt, bool) {
 }
 
 void XMLParser::ListTagAction::endTag() {
-    if (this->parser->getParentTagAction() != NULL &&
-        strcmp(this->parser->getParentTagAction()->getTagName(), "slide") == 0) {
+    if (this->hasParentTag(TagType::SLIDE)) {
         assert(this->parser->lists.size() == 1);
         SlideTagAction* sl = static_cast<XMLParser::SlideTagAction*>(this->parser->getParentTagAction());
         sl->list.insert(sl->list.begin(), this->parser->lists[0].begin(), this->parser->lists[0].end());
@@ -1321,17 +1299,17 @@ void XMLParser::ListTagAction::endTag() {
 // AttributeList &attributes
 void XMLParser::ConflictOrSupportTagAction::beginTag(const AttributeList&) {
     bool support = true;
-    this->checkParentTag("extension");
 
     this->parser->star = false;
-    if (this->tagName == "conflicts")
+    buffer.clear();
+    if (this->type == TagType::CONFLICTS)
         support = false;
 
     static_cast<XMLParser::ExtensionTagAction*>(this->parser->getParentTagAction())->constraint->isSupport = support;
 }
 
 // UTF8String txt, bool last
-void XMLParser::ConflictOrSupportTagAction::text(const UTF8String txt, bool) {
+void XMLParser::ConflictOrSupportTagAction::text(const UTF8String txt, bool last) {
     XConstraintExtension* ctr = static_cast<XMLParser::ExtensionTagAction*>(this->parser->getParentTagAction())->constraint;
     if (this->parser->lists[0].size() == 1 && this->parser->lists[0][0]->id != "%...") {
         std::vector<XIntegerEntity*> tmplist;
@@ -1342,10 +1320,24 @@ void XMLParser::ConflictOrSupportTagAction::text(const UTF8String txt, bool) {
                 ctr->tuples.back().push_back(val);
             }
         }
+    } else if (this->parser->threads > 1) {
+        // the tuples are parsed all at once: directly if the whole text is given, at the end of the tag otherwise
+        if (last && buffer.empty())
+            this->parser->star |= this->parser->parseTuplesInParallel(txt, ctr->tuples);
+        else
+            buffer.insert(buffer.end(), txt.begin().getPointer(), txt.begin().getPointer() + txt.byteLength());
     } else
         this->parser->star |= this->parser->parseTuples(txt, ctr->tuples);
 }
 
+void XMLParser::ConflictOrSupportTagAction::endTag() {
+    if (buffer.empty())
+        return;
+    XConstraintExtension* ctr = static_cast<XMLParser::ExtensionTagAction*>(this->parser->getParentTagAction())->constraint;
+    this->parser->star |= this->parser->parseTuplesInParallel(UTF8String(buffer.data(), buffer.data() + buffer.size()), ctr->tuples);
+    std::vector<UTF8String::Byte>().swap(buffer);
+}
+
 /***************************************************************************
  * Actions performed on GROUP tag
  ****************************************************************************/
@@ -1353,19 +1345,20 @@ void XMLParser::ConflictOrSupportTagAction::text(const UTF8String txt, bool) {
 void XMLParser::GroupTagAction::beginTag(const AttributeList& attributes) {
     std::string lid, tmp;
     //this->checkParentTag("constraints");
-    attributes["id"].to(lid);
+    attributes[AttributeType::ID].to(lid);
 
-    if (!attributes["class"].isNull())
-        attributes["class"].to(tmp);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(tmp);
 
-    group = DataPool::ConstraintPool.make<XConstraintGroup>(lid, tmp);
+    group = DataPool::current().ConstraintPool.make<XConstraintGroup>(lid, tmp);
     this->parser->manager->beginGroup(lid);
-    XParameterVariable::max = -1;
+    this->parser->maxParameter = -1;
 }
 
 void XMLParser::GroupTagAction::endTag() {
     if (group->constraint == NULL)
         throw std::runtime_error("<group> constraint is not linked to a classical constraint");
+    group->maxParameter = this->parser->maxParameter;
     this->parser->manager->newConstraintGroup(group);
     this->parser->manager->endGroup();
 }
@@ -1377,16 +1370,16 @@ void XMLParser::GroupTagAction::endTag() {
 void XMLParser::SlideTagAction::beginTag(const AttributeList& attributes) {
     std::string lid, tmp;
     //this->checkParentTag("constraints");
-    attributes["id"].to(lid);
-    if (!attributes["circular"].isNull()) {
+    attributes[AttributeType::ID].to(lid);
+    if (!attributes[AttributeType::CIRCULAR].isNull()) {
         std::string tmp;
-        attributes["circular"].to(tmp);
+        attributes[AttributeType::CIRCULAR].to(tmp);
         circular = (tmp == "true");
     }
-    if (!attributes["class"].isNull())
-        attributes["class"].to(tmp);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(tmp);
 
-    group = DataPool::ConstraintPool.make<XConstraintGroup>(lid, tmp);
+    group = DataPool::current().ConstraintPool.make<XConstraintGroup>(lid, tmp);
     this->parser->lists.clear();
     this->parser->listTag->nbCallsToList = 0;
     this->parser->lists.push_back(std::vector<XVariable*>()); // Be careful, why not ?? see after revision e32b7f8
@@ -1433,9 +1426,9 @@ void XMLParser::SlideTagAction::endTag() {
 void XMLParser::BlockTagAction::beginTag(const AttributeList& attributes) {
     std::string currentClasses, lid;
 
-    attributes["id"].to(lid);
-    if (!attributes["class"].isNull())
-        attributes["class"].to(currentClasses);
+    attributes[AttributeType::ID].to(lid);
+    if (!attributes[AttributeType::CLASS].isNull())
+        attributes[AttributeType::CLASS].to(currentClasses);
     else
         currentClasses = "";
     if (classes.empty())
@@ -1451,9 +1444,9 @@ void XMLParser::BlockTagAction::endTag() {
 }
 
 void XMLParser::IndexTagAction::beginTag(const AttributeList& attributes) {
-    if (!attributes["rank"].isNull()) {
+    if (!attributes[AttributeType::RANK].isNull()) {
         std::string rank;
-        attributes["rank"].to(rank);
+        attributes[AttributeType::RANK].to(rank);
         if (rank == "any")
             this->parser->rank = RankType::ANY;
         if (rank == "first")
@@ -1470,11 +1463,11 @@ void XMLParser::IndexTagAction::text(const UTF8String txt, bool) {
     tmp = trim(tmp);
     if (tmp == "")
         return;
-    if (this->parser->index != NULL && strcmp(this->parser->getParentTagAction(1)->getTagName(), "element") == 0 && this->parser->matrix.size() == 0)
+    if (this->parser->index != NULL && this->hasParentTag(TagType::ELEMENT) && this->parser->matrix.size() == 0)
         throw std::runtime_error("<index> tag must contain only one variable1");
     std::vector<XVariable*> tmpList;
     this->parser->parseSequence(txt, tmpList);
-    if (tmpList.size() > 2 && strcmp(this->parser->getParentTagAction(1)->getTagName(), "element") == 0)
+    if (tmpList.size() > 2 && this->hasParentTag(TagType::ELEMENT))
         throw std::runtime_error("<index> tag must contain only one variable2");
 
     if (this->parser->index2 != NULL)
@@ -1499,16 +1492,16 @@ void XMLParser::IndexTagAction::text(const UTF8String txt, bool) {
 
 // AttributeList &attributes
 void XMLParser::MatrixTagAction::beginTag(const AttributeList& attributes) {
-    if (strcmp(this->parser->getParentTagAction(2)->getTagName(), "slide") == 0)
+    if (this->hasParentTag(TagType::SLIDE, 2))
         throw std::runtime_error("<matrix> can not be used in a <slide>");
 
     this->parser->startRowIndex = 0;
     this->parser->startColIndex = 0;
 
-    if (!attributes["startRowIndex"].isNull())
-        attributes["startRowIndex"].to(this->parser->startRowIndex);
-    if (!attributes["startColIndex"].isNull())
-        attributes["startColIndex"].to(this->parser->startColIndex);
+    if (!attributes[AttributeType::STARTROWINDEX].isNull())
+        attributes[AttributeType::STARTROWINDEX].to(this->parser->startRowIndex);
+    if (!attributes[AttributeType::STARTCOLINDEX].isNull())
+        attributes[AttributeType::STARTCOLINDEX].to(this->parser->startColIndex);
 }
 
 // UTF8String txt, bool last
@@ -1527,9 +1520,9 @@ void XMLParser::MatrixTagAction::text(const UTF8String txt, bool) {
         std::string compactForm;
         name = txt2.substr(0, pos);
         compactForm = txt2.substr(pos);
-        if (this->parser->variablesList[name] == NULL)
+        XVariableArray* varArray = static_cast<XVariableArray*>(this->parser->variablesList.find(name));
+        if (varArray == NULL)
             throw std::runtime_error("Matrix variable " + name + "does not exist");
-        XVariableArray* varArray = static_cast<XVariableArray*>(this->parser->variablesList[name]);
         int nbV = 0;
         std::string tmp;
         // Find the first interval
@@ -1544,8 +1537,8 @@ void XMLParser::MatrixTagAction::text(const UTF8String txt, bool) {
             size_t dot = tmp.find("..");
             if (dot == std::string::npos)
                 continue;
-            int first = std::stoi(tmp.substr(0, dot));
-            int last = std::stoi(tmp.substr(dot + 2));
+            int first = toInt(tmp.substr(0, dot));
+            int last = toInt(tmp.substr(dot + 2));
             nbV = last - first + 1;
             break;
         }
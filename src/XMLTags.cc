@@ -0,0 +1,133 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XMLTags.h"
+#include <cstdint>
+#include <cstring>
+
+using namespace XCSP3Core;
+
+/**
+ * Names are found with a perfect hash: the seeds below were searched (offline) such that
+ * the top bits of the FNV-1a hash of the known names never collide. A lookup is thus one
+ * hash and one comparison with the single candidate name.
+ */
+
+namespace {
+    inline uint32_t fnv1a(uint32_t seed, const unsigned char* s, size_t length) {
+        uint32_t h = seed;
+        for (size_t i = 0; i < length; i++)
+            h = (h ^ s[i]) * 16777619u;
+        return h;
+    }
+
+    const uint32_t tagSeed = 3401; // 8 bits of hash
+    const uint32_t attributeSeed = 46; // 5 bits of hash
+
+    const char* const tagNames[] = {
+        "", "instance", "variables", "var", "array", "domain", "annotations", "decision",
+        "constraints", "extension", "list", "supports", "conflicts", "intension", "allDifferent", "allEqual",
+        "sum", "coeffs", "condition", "ordered", "channel", "lex", "count", "cardinality",
+        "values", "value", "nValues", "instantiation", "group", "args", "minimum", "maximum",
+        "index", "element", "noOverlap", "cumulative", "origins", "lengths", "ends", "heights",
+        "occurs", "stretch", "widths", "operator", "regular", "mdd", "start", "final",
+        "transitions", "patterns", "clause", "objectives", "minimize", "maximize", "except", "matrix",
+        "block", "slide", "circuit", "size",
+    };
+
+    const char* const attributeNames[] = {
+        "id", "class", "type", "as", "size", "for", "case", "zeroIgnored",
+        "closed", "startIndex", "offset", "circular", "rank", "startRowIndex", "startColIndex",
+    };
+
+    // hash -> tag type
+    const unsigned char tagSlots[256] = {
+        0, 0, 0, 8, 0, 0, 0, 53, 0, 0, 0, 0, 0, 7, 29, 0,
+        57, 0, 0, 0, 0, 49, 0, 0, 40, 0, 0, 0, 0, 0, 9, 0,
+        0, 55, 0, 12, 0, 0, 48, 0, 0, 0, 0, 0, 20, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 27, 6, 0, 0, 0, 0, 0,
+        0, 1, 0, 0, 42, 0, 0, 0, 0, 0, 59, 24, 0, 0, 0, 0,
+        0, 0, 0, 47, 0, 0, 0, 0, 0, 0, 0, 15, 0, 0, 0, 43,
+        0, 0, 0, 0, 0, 34, 0, 0, 0, 10, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 26, 0, 0, 0, 0, 32, 0, 0,
+        0, 0, 0, 37, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39, 13, 0,
+        36, 22, 0, 0, 0, 17, 46, 0, 0, 0, 0, 45, 0, 0, 0, 58,
+        0, 33, 0, 0, 0, 51, 52, 0, 56, 0, 5, 0, 0, 0, 0, 0,
+        31, 0, 0, 4, 35, 0, 0, 0, 30, 0, 0, 38, 0, 0, 0, 0,
+        0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        16, 0, 0, 19, 0, 0, 0, 28, 0, 0, 50, 0, 54, 41, 0, 0,
+        0, 0, 0, 23, 0, 0, 0, 0, 25, 44, 0, 0, 0, 0, 0, 14,
+        0, 0, 0, 18, 0, 0, 0, 0, 21, 0, 0, 0, 0, 11, 3, 0,
+    };
+
+    // hash -> attribute type
+    const unsigned char attributeSlots[32] = {
+        15, 15, 8, 5, 9, 15, 10, 13, 12, 4, 15, 14, 0, 15, 7, 2,
+        15, 3, 6, 15, 15, 1, 15, 11, 15, 15, 15, 15, 15, 15, 15, 15,
+    };
+
+    inline bool sameName(const char* name, const unsigned char* s, size_t length) {
+        return strlen(name) == length && memcmp(name, s, length) == 0;
+    }
+} // namespace
+
+TagType XCSP3Core::tagType(const unsigned char* name, size_t length) {
+    unsigned char type = tagSlots[fnv1a(tagSeed, name, length) >> 24];
+    if (type == 0 || !sameName(tagNames[type], name, length))
+        return TagType::UNKNOWN;
+    return static_cast<TagType>(type);
+}
+
+AttributeType XCSP3Core::attributeType(const unsigned char* name, size_t length) {
+    unsigned char type = attributeSlots[fnv1a(attributeSeed, name, length) >> 27];
+    if (type == static_cast<unsigned char>(AttributeType::NB) || !sameName(attributeNames[type], name, length))
+        return AttributeType::NB;
+    return static_cast<AttributeType>(type);
+}
+
+const char* XCSP3Core::tagName(TagType type) {
+    return tagNames[static_cast<int>(type)];
+}
+
+TagType XCSP3Core::parentTagType(TagType type) {
+    switch (type) {
+    case TagType::VARIABLES:
+    case TagType::CONSTRAINTS:
+    case TagType::OBJECTIVES:
+        return TagType::INSTANCE;
+    case TagType::VAR:
+    case TagType::ARRAY:
+        return TagType::VARIABLES;
+    case TagType::DOMAIN:
+        return TagType::ARRAY;
+    case TagType::MINIMIZE:
+    case TagType::MAXIMIZE:
+        return TagType::OBJECTIVES;
+    case TagType::SUPPORTS:
+    case TagType::CONFLICTS:
+        return TagType::EXTENSION;
+    default:
+        return TagType::UNKNOWN;
+    }
+}
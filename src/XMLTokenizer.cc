@@ -0,0 +1,292 @@
+/*=============================================================================
+ * parser for CSP instances represented in XCSP3 Format
+ *
+ * Copyright (c) 2015 xcsp.org (contact <at> xcsp.org)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ *=============================================================================
+ */
+#include "XMLTokenizer.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace XCSP3Core;
+
+namespace {
+    inline bool isSpace(char c) {
+        return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    }
+
+    inline bool isNameEnd(char c) {
+        return isSpace(c) || c == '>' || c == '/' || c == '=';
+    }
+
+    const char* find(const char* b, const char* e, const char* s, size_t length) {
+        return static_cast<const char*>(memmem(b, e - b, s, length));
+    }
+
+    inline const XMLTokenizer::Byte* bytes(const char* s) {
+        return reinterpret_cast<const XMLTokenizer::Byte*>(s);
+    }
+
+    /**
+     * Accept the encodings which are (a subset of) UTF-8
+     */
+    bool isUTF8(std::string encoding) {
+        std::transform(encoding.begin(), encoding.end(), encoding.begin(), ::tolower);
+        return encoding == "utf-8" || encoding == "utf8" || encoding == "us-ascii" || encoding == "ascii";
+    }
+} // namespace
+
+bool XMLTokenizer::handles(const char* data, size_t size) {
+    const char *p = data, *e = data + size;
+
+    if (size >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0) // UTF-8 byte order mark
+        p += 3;
+    if (p == e || *p != '<') // UTF-16/32, or anything unexpected: let libxml2 decide
+        return false;
+
+    // the encoding given by the XML declaration
+    if (e - p >= 5 && memcmp(p, "<?xml", 5) == 0) {
+        const char* declEnd = find(p, e, "?>", 2);
+        if (declEnd == nullptr)
+            return false;
+        const char* enc = find(p, declEnd, "encoding", 8);
+        if (enc != nullptr) {
+            enc = std::find_if(enc + 8, declEnd, [](char c) { return c == '"' || c == '\''; });
+            if (enc == declEnd)
+                return false;
+            const char* encEnd = std::find(enc + 1, declEnd, *enc);
+            if (encEnd == declEnd || !isUTF8(std::string(enc + 1, encEnd)))
+                return false;
+        }
+    }
+
+    // entity and character references
+    if (memchr(p, '&', e - p) != nullptr)
+        return false;
+
+    // DOCTYPE, CDATA sections... everything but comments
+    for (const char* m = find(p, e, "<!", 2); m != nullptr; m = find(m, e, "<!", 2)) {
+        if (e - m < 4 || m[2] != '-' || m[3] != '-')
+            return false;
+        m = find(m + 4, e, "-->", 3);
+        if (m == nullptr)
+            return false;
+    }
+    return true;
+}
+
+void XMLTokenizer::parse(const char* data, size_t size) {
+    begin = cur = data;
+    end = data + size;
+    openTags.clear();
+
+    if (size >= 3 && memcmp(cur, "\xEF\xBB\xBF", 3) == 0)
+        cur += 3;
+
+    bool rootSeen = false;
+    parser->startDocument();
+
+    while (cur < end) {
+        // text up to the next markup: this is where tuple-heavy documents spend their bytes
+        const char* lt = static_cast<const char*>(memchr(cur, '<', end - cur));
+        const char* textEnd = lt != nullptr ? lt : end;
+        if (textEnd + 1 == end) // a '<' ending the document
+            error("unexpected end of document");
+        if (textEnd > cur)
+            text(cur, textEnd);
+        cur = textEnd;
+        if (cur == end)
+            break;
+
+        switch (cur[1]) {
+            case '/':
+                endTag();
+                break;
+            case '?':
+                skipPast("?>", 2);
+                break;
+            case '!':
+                if (end - cur < 4 || cur[2] != '-' || cur[3] != '-')
+                    error("unsupported markup");
+                cur += 4;
+                skipPast("-->", 3);
+                break;
+            default:
+                if (rootSeen && openTags.empty())
+                    error("extra content at the end of the document");
+                rootSeen = true;
+                startTag();
+        }
+    }
+
+    if (!rootSeen)
+        error("document is empty");
+    if (!openTags.empty())
+        error("premature end of data: missing end tags");
+
+    parser->endDocument();
+}
+
+int XMLTokenizer::line() const {
+    return 1 + static_cast<int>(std::count(begin, cur, '\n'));
+}
+
+void XMLTokenizer::text(const char* b, const char* e) {
+    if (openTags.empty()) {
+        if (std::find_if(b, e, [](char c) { return !isSpace(c); }) != e)
+            error("text found outside the root element");
+        return;
+    }
+    // the text is complete unless a comment or a processing instruction comes next
+    if (e + 1 < end && e[1] != '!' && e[1] != '?')
+        parser->wholeText(UTF8String(bytes(b), bytes(e)));
+    else
+        parser->characters(UTF8String(bytes(b), bytes(e)));
+}
+
+void XMLTokenizer::startTag() {
+    const char* p = cur + 1;
+    const char* name = p;
+    while (p < end && !isNameEnd(*p))
+        ++p;
+    const char* nameEnd = p;
+    if (name == nameEnd)
+        error("invalid element name");
+
+    attributes.clear();
+    bool empty = false;
+    size_t scratchSize = 0;
+    for (;;) {
+        const char* sep = p;
+        skipSpaces(p);
+        if (p == end)
+            error("unexpected end of document in a start tag");
+        if (*p == '>') {
+            ++p;
+            break;
+        }
+        if (*p == '/') {
+            if (p + 1 == end || p[1] != '>')
+                error("invalid start tag");
+            p += 2;
+            empty = true;
+            break;
+        }
+        if (sep == p)
+            error("attributes must be separated by white space");
+
+        Attribute a;
+        a.name = p;
+        while (p < end && !isNameEnd(*p))
+            ++p;
+        a.nameEnd = p;
+        if (a.name == a.nameEnd)
+            error("invalid attribute name");
+        skipSpaces(p);
+        if (p == end || *p != '=')
+            error("attribute without value");
+        ++p;
+        skipSpaces(p);
+        if (p == end || (*p != '"' && *p != '\''))
+            error("attribute value must be quoted");
+        a.value = p + 1;
+        a.valueEnd = static_cast<const char*>(memchr(a.value, *p, end - a.value));
+        if (a.valueEnd == nullptr)
+            error("unterminated attribute value");
+        if (memchr(a.value, '<', a.valueEnd - a.value) != nullptr)
+            error("'<' is not allowed in attribute values");
+        p = a.valueEnd + 1;
+
+        attributes.push_back(a);
+        scratchSize += (a.nameEnd - a.name) + (a.valueEnd - a.value) + 2;
+    }
+
+    // AttributeList expects a NULL terminated list of NUL terminated names and values
+    scratch.resize(scratchSize);
+    attrList.resize(2 * attributes.size() + 1);
+    Byte* s = scratch.data();
+    size_t i = 0;
+    for (const Attribute& a : attributes) {
+        attrList[i++] = s;
+        s = std::copy(bytes(a.name), bytes(a.nameEnd), s);
+        *s++ = 0;
+        attrList[i++] = s;
+        // attribute value normalization: each white space (or \r\n) becomes a space
+        for (const char* v = a.value; v < a.valueEnd; ++v) {
+            if (*v == '\r' && v + 1 < a.valueEnd && v[1] == '\n')
+                ++v;
+            *s++ = isSpace(*v) ? ' ' : *v;
+        }
+        *s++ = 0;
+    }
+    attrList[i] = nullptr;
+
+    UTF8String tag(bytes(name), bytes(nameEnd));
+    openTags.push_back(tag);
+    cur = p;
+
+    AttributeList list(attrList.data());
+    parser->startElement(tag, list);
+    if (empty) {
+        openTags.pop_back();
+        parser->endElement(tag);
+    }
+}
+
+void XMLTokenizer::endTag() {
+    const char* p = cur + 2;
+    const char* name = p;
+    while (p < end && !isNameEnd(*p))
+        ++p;
+    const char* nameEnd = p;
+    skipSpaces(p);
+    if (p == end || *p != '>')
+        error("invalid end tag");
+
+    if (openTags.empty())
+        error("end tag without start tag");
+    const UTF8String& open = openTags.back();
+    if (open.byteLength() != nameEnd - name || memcmp(open.begin().getPointer(), name, nameEnd - name) != 0)
+        error("opening and ending tag mismatch");
+
+    cur = p + 1;
+    UTF8String tag = open;
+    openTags.pop_back();
+    parser->endElement(tag);
+}
+
+void XMLTokenizer::skipPast(const char* terminator, size_t length) {
+    const char* p = find(cur, end, terminator, length);
+    if (p == nullptr)
+        error("unterminated comment or processing instruction");
+    cur = p + length;
+}
+
+void XMLTokenizer::skipSpaces(const char*& p) {
+    while (p < end && isSpace(*p))
+        ++p;
+}
+
+void XMLTokenizer::error(const char* message) {
+    throw std::runtime_error(std::string("XML error: ") + message);
+}